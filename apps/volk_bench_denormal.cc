@@ -0,0 +1,155 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Shows what denormals cost and what volk_fp_env_enter buys back. Each
+ * kernel runs on normal inputs and on the tiny values a decaying IIR or
+ * AGC tail leaves behind, once in the default IEEE environment and once
+ * between volk_fp_env_enter and volk_fp_env_leave. The last workload is
+ * the tail itself: one-pole filters ringing down into the denormal range,
+ * one volk_32f_s32f_multiply_32f and volk_32f_x2_add_32f per block.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+//the best of a few repetitions, in nanoseconds per point
+template <typename F>
+static double ns_per_point(F call, unsigned int iter, unsigned int len)
+{
+    double best = 0.0;
+    for(int rep = 0; rep < 5; rep++) {
+        const auto start = std::chrono::steady_clock::now();
+        for(unsigned int i = 0; i < iter; i++) call();
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        const double ns = elapsed.count() / iter / len;
+        if(rep == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+//times call in the default environment and in the machine's
+template <typename F>
+static void compare(const char *kernel, const char *input, F call,
+                    unsigned int iter, unsigned int len)
+{
+    const double ieee = ns_per_point(call, iter, len);
+    volk_fp_env_t env;
+    volk_fp_env_enter(&env);
+    const double flushed = ns_per_point(call, iter, len);
+    volk_fp_env_leave(&env);
+    printf("%-28s %-9s %12.3f %12.3f %9.1fx\n", kernel, input, ieee, flushed, ieee / flushed);
+}
+
+int main(int argc, char **argv)
+{
+    po::options_description desc("Program options: volk_bench_denormal [options]");
+    po::variables_map vm;
+    unsigned int iter;
+    unsigned int len;
+
+    desc.add_options()
+        ("help,h", "print help message")
+        ("iter,i", po::value<unsigned int>(&iter)->default_value(2000),
+         "calls per measurement")
+        ("len,l", po::value<unsigned int>(&len)->default_value(4096),
+         "vector length")
+        ;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (po::error& error) {
+        std::cerr << "Error: " << error.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+    if(vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    if(len == 0 || iter == 0) {
+        std::cerr << "Error: need a length and at least one iteration" << std::endl;
+        return 1;
+    }
+
+    volk_init();
+    const size_t alignment = volk_get_alignment();
+    float *normal = (float *)volk_malloc(len * sizeof(float), alignment);
+    float *tiny = (float *)volk_malloc(len * sizeof(float), alignment);
+    float *taps = (float *)volk_malloc(len * sizeof(float), alignment);
+    float *out = (float *)volk_malloc(len * sizeof(float), alignment);
+    float *state = (float *)volk_malloc(len * sizeof(float), alignment);
+    float *input = (float *)volk_malloc(len * sizeof(float), alignment);
+    float dot = 0.0f;
+    for(unsigned int i = 0; i < len; i++) {
+        normal[i] = 1.0f + (float)(i % 17) * 0.125f;
+        tiny[i] = 1e-39f * (float)(i % 17 + 1);
+        taps[i] = 0.5f + (float)(i % 5) * 0.0625f;
+        input[i] = 0.0f;
+    }
+
+    printf("machine %s, %u points\n", volk_get_machine(), len);
+    printf("%-28s %-9s %12s %12s %10s\n", "kernel", "input", "ieee ns/pt", "fp env ns/pt", "speedup");
+
+    compare("volk_32f_s32f_multiply_32f", "normal",
+            [&]{ volk_32f_s32f_multiply_32f(out, normal, 0.75f, len); }, iter, len);
+    compare("volk_32f_s32f_multiply_32f", "denormal",
+            [&]{ volk_32f_s32f_multiply_32f(out, tiny, 0.75f, len); }, iter, len);
+    compare("volk_32f_x2_multiply_32f", "normal",
+            [&]{ volk_32f_x2_multiply_32f(out, normal, taps, len); }, iter, len);
+    compare("volk_32f_x2_multiply_32f", "denormal",
+            [&]{ volk_32f_x2_multiply_32f(out, tiny, taps, len); }, iter, len);
+    compare("volk_32f_x2_dot_prod_32f", "normal",
+            [&]{ volk_32f_x2_dot_prod_32f(&dot, normal, taps, len); }, iter, len);
+    compare("volk_32f_x2_dot_prod_32f", "denormal",
+            [&]{ volk_32f_x2_dot_prod_32f(&dot, tiny, taps, len); }, iter, len);
+
+    //len parallel one-pole filters, y = 0.99 y + x, at the end of their
+    //ring down; restarted every call so each measurement sees the same tail
+    const unsigned int blocks = 64;
+    compare("iir tail (64 blocks)", "decaying", [&]{
+        for(unsigned int i = 0; i < len; i++) state[i] = 1.2e-38f;
+        for(unsigned int b = 0; b < blocks; b++) {
+            volk_32f_s32f_multiply_32f(state, state, 0.99f, len);
+            volk_32f_x2_add_32f(state, state, input, len);
+        }
+    }, iter / blocks + 1, len * blocks);
+
+    volk_free(normal);
+    volk_free(tiny);
+    volk_free(taps);
+    volk_free(out);
+    volk_free(state);
+    volk_free(input);
+    return 0;
+}
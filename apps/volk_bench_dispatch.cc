@@ -0,0 +1,159 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Measures what a call through the public entry point costs on short
+ * vectors. Each kernel is timed through volk_x, the dispatcher pointer,
+ * or with ENABLE_IFUNC through volk_x_ifunc, the load time resolved
+ * function, and through volk_x_u, a plain pointer to the bound kernel. The gap between
+ * the two is the per-call dispatch overhead; run the benchmark against
+ * both builds to compare the schemes.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+#if defined(VOLK_IFUNC)
+#define VOLK_ENTRY(kern) kern##_ifunc
+#else
+#define VOLK_ENTRY(kern) kern
+#endif
+
+//the best of a few repetitions, in nanoseconds per call
+template <typename F>
+static double ns_per_call(F call, unsigned int iter)
+{
+    double best = 0.0;
+    for(int rep = 0; rep < 5; rep++) {
+        const auto start = std::chrono::steady_clock::now();
+        for(unsigned int i = 0; i < iter; i++) call();
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        const double ns = elapsed.count() / iter;
+        if(rep == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+static void report(const char *kernel, unsigned int len, double entry, double direct)
+{
+    printf("%-28s %6u %12.2f %12.2f %+12.2f\n", kernel, len, entry, direct, entry - direct);
+}
+
+int main(int argc, char **argv)
+{
+    po::options_description desc("Program options: volk_bench_dispatch [options]");
+    po::variables_map vm;
+    unsigned int iter;
+    std::string lens_arg;
+
+    desc.add_options()
+        ("help,h", "print help message")
+        ("iter,i", po::value<unsigned int>(&iter)->default_value(200000),
+         "calls per measurement")
+        ("lens,l", po::value<std::string>(&lens_arg)->default_value("8,16,32,64,128,256"),
+         "comma separated vector lengths")
+        ;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (po::error& error) {
+        std::cerr << "Error: " << error.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+    if(vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    std::vector<unsigned int> lens;
+    std::istringstream lens_stream(lens_arg);
+    std::string len;
+    while(std::getline(lens_stream, len, ',')) {
+        const unsigned int n = (unsigned int)std::strtoul(len.c_str(), NULL, 10);
+        if(n > 0) lens.push_back(n);
+    }
+    if(lens.empty() || iter == 0) {
+        std::cerr << "Error: need at least one length and iteration" << std::endl;
+        return 1;
+    }
+    const unsigned int max_len = *std::max_element(lens.begin(), lens.end());
+
+    volk_init();
+    const size_t alignment = volk_get_alignment();
+    float *a = (float *)volk_malloc(max_len * sizeof(float), alignment);
+    float *b = (float *)volk_malloc(max_len * sizeof(float), alignment);
+    float *c = (float *)volk_malloc(max_len * sizeof(float), alignment);
+    lv_32fc_t *x = (lv_32fc_t *)volk_malloc(max_len * sizeof(lv_32fc_t), alignment);
+    lv_32fc_t *y = (lv_32fc_t *)volk_malloc(max_len * sizeof(lv_32fc_t), alignment);
+    lv_32fc_t *z = (lv_32fc_t *)volk_malloc(max_len * sizeof(lv_32fc_t), alignment);
+    float dot = 0.0f;
+    for(unsigned int i = 0; i < max_len; i++) {
+        a[i] = 1.0f / (float)(i + 1);
+        b[i] = (float)(i % 7);
+        x[i] = lv_cmake(a[i], b[i]);
+        y[i] = lv_cmake(b[i], a[i]);
+    }
+
+#if defined(VOLK_IFUNC)
+    printf("entry points: IFUNC, machine %s\n", volk_get_machine());
+#else
+    printf("entry points: dispatcher pointers, machine %s\n", volk_get_machine());
+#endif
+    printf("%-28s %6s %12s %12s %12s\n", "kernel", "len", "entry ns", "direct ns", "overhead");
+
+    for(size_t l = 0; l < lens.size(); l++) {
+        const unsigned int n = lens[l];
+        report("volk_32f_x2_add_32f", n,
+               ns_per_call([&]{ VOLK_ENTRY(volk_32f_x2_add_32f)(c, a, b, n); }, iter),
+               ns_per_call([&]{ volk_32f_x2_add_32f_u(c, a, b, n); }, iter));
+        report("volk_32fc_x2_multiply_32fc", n,
+               ns_per_call([&]{ VOLK_ENTRY(volk_32fc_x2_multiply_32fc)(z, x, y, n); }, iter),
+               ns_per_call([&]{ volk_32fc_x2_multiply_32fc_u(z, x, y, n); }, iter));
+        report("volk_32f_x2_dot_prod_32f", n,
+               ns_per_call([&]{ VOLK_ENTRY(volk_32f_x2_dot_prod_32f)(&dot, a, b, n); }, iter),
+               ns_per_call([&]{ volk_32f_x2_dot_prod_32f_u(&dot, a, b, n); }, iter));
+    }
+
+    volk_free(a);
+    volk_free(b);
+    volk_free(c);
+    volk_free(x);
+    volk_free(y);
+    volk_free(z);
+    return 0;
+}
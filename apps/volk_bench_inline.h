@@ -0,0 +1,47 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_BENCH_INLINE_H
+#define INCLUDED_VOLK_BENCH_INLINE_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+
+__VOLK_DECL_BEGIN
+
+//the architecture volk_inline.h was compiled for
+const char *volk_bench_inline_target(void);
+
+//each runs its kernel iter times through volk_inline.h
+void volk_bench_inline_add(float *c, const float *a, const float *b,
+                           unsigned int num_points, unsigned int iter);
+void volk_bench_inline_multiply(lv_32fc_t *z, const lv_32fc_t *x, const lv_32fc_t *y,
+                                unsigned int num_points, unsigned int iter);
+void volk_bench_inline_dot(float *result, const float *a, const float *b,
+                           unsigned int num_points, unsigned int iter);
+//a multiply followed by an add on the same block
+void volk_bench_inline_chain(float *c, const float *a, const float *b,
+                             unsigned int num_points, unsigned int iter);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_BENCH_INLINE_H */
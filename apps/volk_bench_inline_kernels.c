@@ -0,0 +1,79 @@
+/* -*- c -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * The inline half of volk_bench_inline: the same loops as the dynamic
+ * half, but built against volk_inline.h so each call can be inlined.
+ */
+
+#include <volk/volk_inline.h>
+#include "volk_bench_inline.h"
+
+const char *volk_bench_inline_target(void)
+{
+#if defined(LV_HAVE_AVX512F)
+    return "avx512f";
+#elif defined(LV_HAVE_AVX2)
+    return "avx2";
+#elif defined(LV_HAVE_AVX)
+    return "avx";
+#elif defined(LV_HAVE_SSE4_1)
+    return "sse4_1";
+#elif defined(LV_HAVE_SSE2)
+    return "sse2";
+#elif defined(LV_HAVE_NEON)
+    return "neon";
+#else
+    return "generic";
+#endif
+}
+
+void volk_bench_inline_add(float *c, const float *a, const float *b,
+                           unsigned int num_points, unsigned int iter)
+{
+    unsigned int i;
+    for(i = 0; i < iter; i++) volk_32f_x2_add_32f(c, a, b, num_points);
+}
+
+void volk_bench_inline_multiply(lv_32fc_t *z, const lv_32fc_t *x, const lv_32fc_t *y,
+                                unsigned int num_points, unsigned int iter)
+{
+    unsigned int i;
+    for(i = 0; i < iter; i++) volk_32fc_x2_multiply_32fc(z, x, y, num_points);
+}
+
+void volk_bench_inline_dot(float *result, const float *a, const float *b,
+                           unsigned int num_points, unsigned int iter)
+{
+    unsigned int i;
+    for(i = 0; i < iter; i++) volk_32f_x2_dot_prod_32f(result, a, b, num_points);
+}
+
+void volk_bench_inline_chain(float *c, const float *a, const float *b,
+                             unsigned int num_points, unsigned int iter)
+{
+    unsigned int i;
+    for(i = 0; i < iter; i++) {
+        volk_32f_x2_multiply_32f(c, a, b, num_points);
+        volk_32f_x2_add_32f(c, c, a, num_points);
+    }
+}
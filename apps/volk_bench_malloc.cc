@@ -0,0 +1,148 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Allocate/free churn at block rate, the way a flowgraph of blocks that
+ * allocate work buffers per call uses volk_malloc. Every thread keeps a
+ * ring of live buffers and replaces the oldest one on each step, with
+ * sizes cycling through typical block lengths. The same loop runs on
+ * posix_memalign/free and on volk_malloc/volk_free; unless
+ * VOLK_MALLOC_POOL is already set, the benchmark turns the pool on.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+static const size_t sizes[] = {
+    4096, 8192 * sizeof(float), 1024 * sizeof(lv_32fc_t), 32768, 512, 65536 * sizeof(float)
+};
+static const unsigned int nsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+struct system_allocator {
+    static void *alloc(size_t size, size_t alignment)
+    {
+        void *ptr = NULL;
+        return posix_memalign(&ptr, alignment, size) == 0 ? ptr : NULL;
+    }
+    static void release(void *ptr) { free(ptr); }
+};
+
+struct volk_allocator {
+    static void *alloc(size_t size, size_t alignment) { return volk_malloc(size, alignment); }
+    static void release(void *ptr) { volk_free(ptr); }
+};
+
+template <typename A>
+static void churn(unsigned int iter, unsigned int live, size_t alignment)
+{
+    std::vector<void *> ring(live, (void *)NULL);
+    for(unsigned int i = 0; i < iter; i++) {
+        const unsigned int slot = i % live;
+        A::release(ring[slot]);
+        ring[slot] = A::alloc(sizes[i % nsizes], alignment);
+        //touch the block like a kernel writing its first samples would
+        if(ring[slot] != NULL) *(volatile char *)ring[slot] = (char)i;
+    }
+    for(unsigned int slot = 0; slot < live; slot++) A::release(ring[slot]);
+}
+
+//nanoseconds per allocate/free pair, over all threads
+template <typename A>
+static double ns_per_pair(unsigned int nthreads, unsigned int iter, unsigned int live, size_t alignment)
+{
+    double best = 0.0;
+    for(int rep = 0; rep < 3; rep++) {
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for(unsigned int t = 0; t < nthreads; t++) {
+            threads.push_back(std::thread(churn<A>, iter, live, alignment));
+        }
+        for(unsigned int t = 0; t < nthreads; t++) threads[t].join();
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        const double ns = elapsed.count() / ((double)iter * nthreads);
+        if(rep == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    po::options_description desc("Program options: volk_bench_malloc [options]");
+    po::variables_map vm;
+    unsigned int iter;
+    unsigned int live;
+    unsigned int max_threads;
+
+    desc.add_options()
+        ("help,h", "print help message")
+        ("iter,i", po::value<unsigned int>(&iter)->default_value(200000),
+         "allocations per thread")
+        ("live,l", po::value<unsigned int>(&live)->default_value(8),
+         "buffers each thread holds at once")
+        ("threads,t", po::value<unsigned int>(&max_threads)->default_value(8),
+         "largest thread count, doubled from 1")
+        ;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (po::error& error) {
+        std::cerr << "Error: " << error.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+    if(vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    if(iter == 0 || live == 0 || max_threads == 0) {
+        std::cerr << "Error: need at least one iteration, buffer and thread" << std::endl;
+        return 1;
+    }
+
+    if(getenv("VOLK_MALLOC_POOL") == NULL) setenv("VOLK_MALLOC_POOL", "1", 1);
+    const size_t alignment = volk_get_alignment();
+    printf("volk_malloc %s the pool, alignment %u\n",
+           volk_malloc_is_pooled() ? "uses" : "does not use", (unsigned int)alignment);
+    printf("%8s %14s %14s %10s\n", "threads", "system ns", "volk ns", "speedup");
+
+    for(unsigned int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        const double sys = ns_per_pair<system_allocator>(nthreads, iter, live, alignment);
+        const double vlk = ns_per_pair<volk_allocator>(nthreads, iter, live, alignment);
+        printf("%8u %14.1f %14.1f %9.2fx\n", nthreads, sys, vlk, sys / vlk);
+    }
+    return 0;
+}
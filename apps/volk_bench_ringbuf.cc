@@ -0,0 +1,209 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * A streaming FIR the way blocks write it: every block of input is
+ * appended to the filter history and each output is a
+ * volk_32f_x2_dot_prod_32f over the last ntaps samples. The linear
+ * version copies the last ntaps - 1 samples to the front of its buffer
+ * before every block; the ring version writes into a volk_ringbuf and
+ * lets the dot products read across the wrap. Both are timed with and
+ * without the filtering, so the bookkeeping cost shows on its own.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+#include <volk/volk_ringbuf.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+//history + one block, the tail moved to the front each time
+struct linear_stream {
+    float *buf;
+    unsigned int ntaps;
+    unsigned int block;
+
+    float *push(const float *in)
+    {
+        memmove(buf, buf + block, (ntaps - 1) * sizeof(float));
+        memcpy(buf + ntaps - 1, in, block * sizeof(float));
+        return buf;
+    }
+};
+
+//a ring of at least history + one block, written in place
+struct ring_stream {
+    float *ring;
+    size_t len;
+    size_t write;
+    unsigned int ntaps;
+    unsigned int block;
+
+    float *push(const float *in)
+    {
+        memcpy(ring + write, in, block * sizeof(float));
+        float *first = ring + (write + len - (ntaps - 1)) % len;
+        write = (write + block) % len;
+        return first;
+    }
+};
+
+template <typename S>
+static double ns_per_block(S &stream, const float *in, const float *taps, float *out,
+                           unsigned int nblocks, bool filter)
+{
+    double best = 0.0;
+    for(int rep = 0; rep < 5; rep++) {
+        const auto start = std::chrono::steady_clock::now();
+        for(unsigned int b = 0; b < nblocks; b++) {
+            const float *hist = stream.push(in + (b % 4) * stream.block);
+            if(!filter) continue;
+            for(unsigned int n = 0; n < stream.block; n++) {
+                volk_32f_x2_dot_prod_32f(out + n, hist + n, taps, stream.ntaps);
+            }
+        }
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        const double ns = elapsed.count() / nblocks;
+        if(rep == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    po::options_description desc("Program options: volk_bench_ringbuf [options]");
+    po::variables_map vm;
+    unsigned int block;
+    unsigned int nblocks;
+    std::string taps_arg;
+
+    desc.add_options()
+        ("help,h", "print help message")
+        ("block,b", po::value<unsigned int>(&block)->default_value(4096),
+         "samples per block")
+        ("blocks,n", po::value<unsigned int>(&nblocks)->default_value(200),
+         "blocks per measurement")
+        ("taps,t", po::value<std::string>(&taps_arg)->default_value("16,64,256,1024"),
+         "comma separated tap counts")
+        ;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (po::error& error) {
+        std::cerr << "Error: " << error.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+    if(vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    std::vector<unsigned int> ntaps_list;
+    std::istringstream taps_stream(taps_arg);
+    std::string item;
+    while(std::getline(taps_stream, item, ',')) {
+        const unsigned int n = (unsigned int)std::strtoul(item.c_str(), NULL, 10);
+        if(n > 0) ntaps_list.push_back(n);
+    }
+    if(ntaps_list.empty() || block == 0 || nblocks == 0) {
+        std::cerr << "Error: need taps, a block length and at least one block" << std::endl;
+        return 1;
+    }
+
+    volk_init();
+    const size_t alignment = volk_get_alignment();
+    float *in = (float *)volk_malloc(4 * block * sizeof(float), alignment);
+    float *out = (float *)volk_malloc(block * sizeof(float), alignment);
+    for(unsigned int i = 0; i < 4 * block; i++) in[i] = std::sin(0.01f * (float)i);
+
+    printf("%-6s %-7s %14s %14s %14s %14s\n", "taps", "stream",
+           "copy ns/blk", "fir ns/blk", "fir ns/out", "max diff");
+
+    for(size_t t = 0; t < ntaps_list.size(); t++) {
+        const unsigned int ntaps = ntaps_list[t];
+        float *taps = (float *)volk_malloc(ntaps * sizeof(float), alignment);
+        for(unsigned int i = 0; i < ntaps; i++) taps[i] = 1.0f / (float)(i + 1);
+
+        linear_stream linear;
+        linear.buf = (float *)volk_malloc((ntaps - 1 + block) * sizeof(float), alignment);
+        linear.ntaps = ntaps;
+        linear.block = block;
+        memset(linear.buf, 0, (ntaps - 1 + block) * sizeof(float));
+
+        size_t ring_size = 0;
+        ring_stream ring;
+        ring.ring = (float *)volk_ringbuf_alloc((ntaps + block) * sizeof(float), &ring_size);
+        if(ring.ring == NULL) {
+            std::cerr << "Error: no ring buffer on this system" << std::endl;
+            return 1;
+        }
+        ring.len = ring_size / sizeof(float);
+        ring.write = 0;
+        ring.ntaps = ntaps;
+        ring.block = block;
+        memset(ring.ring, 0, ring_size);
+
+        //both streams must filter to the same outputs
+        std::vector<float> expected(block);
+        float max_diff = 0.0f;
+        for(unsigned int b = 0; b < 2 * ring.len / block + 3; b++) {
+            const float *lin_hist = linear.push(in + (b % 4) * block);
+            const float *ring_hist = ring.push(in + (b % 4) * block);
+            for(unsigned int n = 0; n < block; n++) {
+                volk_32f_x2_dot_prod_32f(&expected[n], lin_hist + n, taps, ntaps);
+                volk_32f_x2_dot_prod_32f(out + n, ring_hist + n, taps, ntaps);
+                max_diff = std::fmax(max_diff, std::fabs(out[n] - expected[n]));
+            }
+        }
+
+        const double lin_copy = ns_per_block(linear, in, taps, out, nblocks * 10, false);
+        const double lin_fir = ns_per_block(linear, in, taps, out, nblocks, true);
+        const double ring_copy = ns_per_block(ring, in, taps, out, nblocks * 10, false);
+        const double ring_fir = ns_per_block(ring, in, taps, out, nblocks, true);
+        printf("%-6u %-7s %14.1f %14.1f %14.3f %14s\n", ntaps, "linear",
+               lin_copy, lin_fir, lin_fir / block, "");
+        printf("%-6u %-7s %14.1f %14.1f %14.3f %14g\n", ntaps, "ring",
+               ring_copy, ring_fir, ring_fir / block, max_diff);
+
+        volk_ringbuf_free(ring.ring, ring_size);
+        volk_free(linear.buf);
+        volk_free(taps);
+    }
+
+    volk_free(in);
+    volk_free(out);
+    return 0;
+}
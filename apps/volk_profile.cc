@@ -27,9 +27,20 @@
 #include <volk/volk.h>
 #include <volk/volk_prefs.h>
 
+#include <algorithm>
+#include <atomic>
 #include <ciso646>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <set>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
 #include <boost/xpressive/xpressive.hpp>
 #include <iostream>
@@ -37,6 +48,11 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace fs = boost::filesystem;
 
 int main(int argc, char *argv[]) {
@@ -55,11 +71,37 @@ int main(int argc, char *argv[]) {
             boost::program_options::value<int>()->default_value( 131071 ),
             "Set the default vector length for tests") // default is a mersenne prime
       ("iter,i",
-            boost::program_options::value<int>()->default_value( 1987 ),
-            "Set the default number of test iterations per kernel")
+            boost::program_options::value<int>()->default_value( 283 ),
+            "Set the default number of test iterations per trial")
+      ("trials,T",
+            boost::program_options::value<int>()->default_value( 7 ),
+            "Number of timed trials per arch; the ranking uses their median")
+      ("bench-vlens,V",
+            boost::program_options::value<std::string>(),
+            "Comma separated vector lengths to time in addition to vlen (reported in the JSON output)")
+      ("residency,r",
+            boost::program_options::value<std::string>(),
+            "Comma separated cache levels to also time in: l1, l2 and llc size the "
+            "working set to half that cache, dram rotates through a ring four times the LLC (up to 1GiB)")
+      ("counters,c",
+            boost::program_options::value<bool>()->default_value( false )
+                                                     ->implicit_value( true ),
+            "Read cycles, instructions, cache misses and AVX license cycles "
+            "through perf_event_open during the trials (Linux)")
+      ("sweep,s",
+            boost::program_options::value<std::string>(),
+            "Comma separated vector lengths below vlen to also profile; "
+            "kernels whose best arch changes get length buckets in volk_config")
       ("tests-regex,R",
             boost::program_options::value<std::string>(),
             "Run tests matching regular expression.")
+      ("jobs,J",
+            boost::program_options::value<int>()->default_value( 1 ),
+            "Profile this many kernels at once, each job pinned to its own core")
+      ("no-smt",
+            boost::program_options::value<bool>()->default_value( false )
+                                                     ->implicit_value( true ),
+            "Never put two jobs on hardware threads of the same core")
       ("update,u",
             boost::program_options::value<bool>()->default_value( false )
                                                      ->implicit_value( true ),
@@ -90,6 +132,13 @@ int main(int argc, char *argv[]) {
     bool update_mode = false;
     bool dry_run = false;
     std::string config_file;
+    std::vector<unsigned int> sweep_lens;
+    int def_trials;
+    std::vector<unsigned int> def_bench_vlens;
+    std::vector<volk_residency_t> def_residencies;
+    int jobs = 1;
+    bool def_counters = false;
+    bool no_smt = false;
 
     // Handle the provided options
     try {
@@ -111,12 +160,36 @@ int main(int argc, char *argv[]) {
         def_kernel_regex = kernel_regex;
         update_mode = vm["update"].as<bool>();
         dry_run = vm["dry-run"].as<bool>();
+        def_counters = vm["counters"].as<bool>();
+        jobs = vm["jobs"].as<int>();
+        no_smt = vm["no-smt"].as<bool>();
+        if ( jobs < 1 ) {
+            throw std::invalid_argument("jobs must be at least 1");
+        }
+        def_trials = vm["trials"].as<int>();
+        if ( def_trials < 1 ) {
+            throw std::invalid_argument("trials must be at least 1");
+        }
+        if ( vm.count("bench-vlens") ) {
+            def_bench_vlens = parse_vlens(vm["bench-vlens"].as<std::string>());
+        }
+        if ( vm.count("residency") ) {
+            def_residencies = parse_residencies(vm["residency"].as<std::string>());
+        }
+        if ( vm.count("sweep") ) {
+            sweep_lens = parse_sweep_lens(vm["sweep"].as<std::string>(), def_vlen);
+        }
     }
     catch (boost::program_options::error& error) {
         std::cerr << "Error: " << error.what() << std::endl << std::endl;
         std::cerr << desc << std::endl;
         return 1;
     }
+    catch (std::invalid_argument& error) {
+        std::cerr << "Error: " << error.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
 
     /** --help option */
     if ( vm.count("help") ) {
@@ -148,7 +221,8 @@ int main(int argc, char *argv[]) {
     }
 
     volk_test_params_t test_params(def_tol, def_scalar, def_vlen, def_iter,
-        def_benchmark_mode, def_kernel_regex);
+        def_benchmark_mode, def_kernel_regex, def_trials, def_bench_vlens, def_residencies,
+        def_counters);
 
     // Run tests
     std::vector<volk_test_results_t> results;
@@ -170,7 +244,8 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    // Iteratate through list of tests running each one
+    // Pick the tests to run
+    std::vector<volk_test_case_t> selected;
     for(unsigned int ii = 0; ii < test_cases.size(); ++ii) {
         bool regex_match = true;
 
@@ -197,14 +272,22 @@ int main(int argc, char *argv[]) {
         }
 
         if( regex_match && update ) {
-            try {
-            run_volk_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
-                test_case.test_parameters(), &results, test_case.puppet_master_name());
-            }
-            catch (std::string error) {
-                std::cerr << "Caught Exception in 'run_volk_tests': " << error << std::endl;
-            }
+            selected.push_back(test_case);
+        }
+    }
 
+    // Run them, in parallel if asked to; the results keep the test order
+    if(jobs > 1 && selected.size() > 1) {
+        std::vector<std::vector<volk_test_results_t> > job_results(selected.size());
+        run_parallel(selected, std::min<size_t>(jobs, selected.size()), no_smt,
+                     sweep_lens, def_vlen, &job_results);
+        for(size_t ii = 0; ii < job_results.size(); ++ii) {
+            results.insert(results.end(), job_results[ii].begin(), job_results[ii].end());
+        }
+    }
+    else {
+        for(size_t ii = 0; ii < selected.size(); ++ii) {
+            profile_test_case(selected[ii], sweep_lens, def_vlen, &results, std::cout);
         }
     }
 
@@ -224,6 +307,193 @@ int main(int argc, char *argv[]) {
     }
 }
 
+std::vector<unsigned int> parse_vlens(const std::string &lens_str)
+{
+    std::vector<unsigned int> lens;
+    std::istringstream lens_stream(lens_str);
+    std::string token;
+    while(std::getline(lens_stream, token, ',')) {
+        char *end = NULL;
+        const unsigned long len = std::strtoul(token.c_str(), &end, 10);
+        if(token.empty() || *end != '\0' || len == 0 || len > std::numeric_limits<unsigned int>::max()) {
+            throw std::invalid_argument("vector lengths must be positive integers: " + token);
+        }
+        lens.push_back((unsigned int)len);
+    }
+    std::sort(lens.begin(), lens.end());
+    lens.erase(std::unique(lens.begin(), lens.end()), lens.end());
+    return lens;
+}
+
+void profile_test_case(volk_test_case_t test_case, const std::vector<unsigned int> &sweep_lens,
+    int def_vlen, std::vector<volk_test_results_t> *results, std::ostream &out)
+{
+    try {
+        run_volk_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
+            test_case.test_parameters(), results, test_case.puppet_master_name(), out);
+
+        // puppets and kernels with their own vlen have length
+        // constraints of their own, so only sweep the plain ones
+        if(!sweep_lens.empty() && test_case.puppet_master_name() == "NULL" &&
+           test_case.test_parameters().vlen() == (unsigned int)def_vlen) {
+            sweep_lengths(test_case, sweep_lens, &results->back(), out);
+        }
+    }
+    catch (std::string error) {
+        std::cerr << "Caught Exception in 'run_volk_tests': " << error << std::endl;
+    }
+}
+
+#if defined(__linux__)
+// the lowest numbered hardware thread sharing a core with cpu
+static int core_of_cpu(int cpu)
+{
+    std::ostringstream path;
+    path << "/sys/devices/system/cpu/cpu" << cpu << "/topology/thread_siblings_list";
+    std::ifstream siblings(path.str().c_str());
+    int first = cpu;
+    if(!(siblings >> first)) return cpu;
+    return first;
+}
+#endif
+
+std::vector<int> pick_job_cpus(size_t jobs, bool no_smt)
+{
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return cpus;
+
+    // one hardware thread per core first, then the siblings unless excluded
+    std::vector<int> cores, siblings;
+    std::set<int> seen_cores;
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if(!CPU_ISSET(cpu, &allowed)) continue;
+        if(seen_cores.insert(core_of_cpu(cpu)).second) cores.push_back(cpu);
+        else siblings.push_back(cpu);
+    }
+    cpus = cores;
+    if(!no_smt) cpus.insert(cpus.end(), siblings.begin(), siblings.end());
+    if(cpus.size() > jobs) cpus.resize(jobs);
+#else
+    (void)jobs;
+    (void)no_smt;
+#endif
+    return cpus;
+}
+
+void run_parallel(const std::vector<volk_test_case_t> &selected, size_t jobs, bool no_smt,
+    const std::vector<unsigned int> &sweep_lens, int def_vlen,
+    std::vector<std::vector<volk_test_results_t> > *job_results)
+{
+    const std::vector<int> cpus = pick_job_cpus(jobs, no_smt);
+    if(!cpus.empty() && cpus.size() < jobs) {
+        std::cout << "Only " << cpus.size() << (no_smt? " cores" : " cpus")
+                  << " available, running " << cpus.size() << " jobs" << std::endl;
+        jobs = cpus.size();
+    }
+
+    // every job takes the next test not yet claimed and writes its report
+    // into that test's slot; finished slots are printed in test order
+    std::atomic<size_t> next_test(0);
+    std::vector<std::ostringstream> reports(selected.size());
+    std::vector<bool> finished(selected.size(), false);
+    size_t next_report = 0;
+    std::mutex report_lock;
+    std::vector<std::thread> workers;
+    for(size_t job = 0; job < jobs; job++) {
+        const int cpu = cpus.empty()? -1 : cpus[job];
+        workers.push_back(std::thread([&, cpu]() {
+#if defined(__linux__)
+            if(cpu >= 0) {
+                cpu_set_t cpu_set;
+                CPU_ZERO(&cpu_set);
+                CPU_SET(cpu, &cpu_set);
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+            }
+#endif
+            for(size_t ii = next_test++; ii < selected.size(); ii = next_test++) {
+                profile_test_case(selected[ii], sweep_lens, def_vlen, &(*job_results)[ii], reports[ii]);
+                std::lock_guard<std::mutex> guard(report_lock);
+                finished[ii] = true;
+                for(; next_report < selected.size() && finished[next_report]; next_report++) {
+                    std::cout << reports[next_report].str() << std::flush;
+                }
+            }
+        }));
+    }
+    for(size_t job = 0; job < workers.size(); job++) {
+        workers[job].join();
+    }
+}
+
+std::vector<volk_residency_t> parse_residencies(const std::string &names_str)
+{
+    std::vector<volk_residency_t> residencies;
+    std::istringstream names_stream(names_str);
+    std::string token;
+    while(std::getline(names_stream, token, ',')) {
+        volk_residency_t residency;
+        if(!volk_residency_from_name(token, &residency)) {
+            throw std::invalid_argument("unknown residency (use l1, l2, llc or dram): " + token);
+        }
+        if(std::find(residencies.begin(), residencies.end(), residency) == residencies.end()) {
+            residencies.push_back(residency);
+        }
+    }
+    return residencies;
+}
+
+std::vector<unsigned int> parse_sweep_lens(const std::string &lens_str, int vlen)
+{
+    std::vector<unsigned int> lens = parse_vlens(lens_str);
+    if(!lens.empty() && lens.back() >= (unsigned int)vlen) {
+        throw std::invalid_argument("sweep lengths must be below vlen");
+    }
+    if(lens.size() > VOLK_MAX_LEN_BUCKETS) {
+        throw std::invalid_argument("volk_config holds at most " +
+            boost::lexical_cast<std::string>(VOLK_MAX_LEN_BUCKETS) + " sweep lengths");
+    }
+    return lens;
+}
+
+void sweep_lengths(volk_test_case_t test_case, const std::vector<unsigned int> &lens,
+    volk_test_results_t *result, std::ostream &out)
+{
+    volk_test_params_t params = test_case.test_parameters();
+    std::vector<volk_test_results_t> sweep;
+
+    // scale the iterations so every length moves as much data as the full run
+    for(size_t i = 0; i < lens.size(); i++) {
+        const double iter = std::ceil((double)params.iter() * params.vlen() / lens[i]);
+        volk_test_params_t sweep_params(params.tol(), params.scalar(), lens[i],
+            (unsigned int)std::min(iter, (double)std::numeric_limits<unsigned int>::max()),
+            params.benchmark_mode(), params.kernel_regex(), params.trials());
+        run_volk_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
+            sweep_params, &sweep, test_case.puppet_master_name(), out);
+        if(sweep.back().best_arch_a.empty() || sweep.back().best_arch_u.empty()) return;
+    }
+
+    // a length below the geometric midpoint of two profiled lengths goes to
+    // the shorter one; neighbours with the same best archs share a bucket
+    result->buckets.clear();
+    for(size_t i = 0; i < lens.size(); i++) {
+        const bool last = (i+1 == lens.size());
+        const unsigned int upper = last? result->vlen : lens[i+1];
+        const std::string &next_a = last? result->best_arch_a : sweep[i+1].best_arch_a;
+        const std::string &next_u = last? result->best_arch_u : sweep[i+1].best_arch_u;
+        if(sweep[i].best_arch_a == next_a && sweep[i].best_arch_u == next_u) continue;
+
+        volk_test_bucket_t bucket;
+        bucket.max_len = (unsigned int)std::sqrt((double)lens[i] * upper);
+        bucket.best_arch_a = sweep[i].best_arch_a;
+        bucket.best_arch_u = sweep[i].best_arch_u;
+        result->buckets.push_back(bucket);
+        out << "Below " << bucket.max_len << " points use " << bucket.best_arch_a
+            << " (aligned), " << bucket.best_arch_u << " (unaligned)" << std::endl;
+    }
+}
+
 void read_results(std::vector<volk_test_results_t> *results)
 {
     char path[1024];
@@ -239,43 +509,25 @@ void read_results(std::vector<volk_test_results_t> *results, std::string path)
     if(fs::exists(config_path)) {
         // a config exists and we are reading results from it
         std::ifstream config(config_path.string().c_str());
-        char config_line[256];
-        while(config.getline(config_line, 255)) {
-            // tokenize the input line by kernel_name unaligned aligned
+        std::string config_line;
+        while(std::getline(config, config_line)) {
+            // tokenize the input line by kernel_name aligned unaligned,
+            // followed by any max_len aligned unaligned length buckets,
             // then push back in the results vector with fields filled in
-
-            std::vector<std::string> single_kernel_result;
-            std::string config_str(config_line);
-            std::size_t str_size = config_str.size();
-            std::size_t found = 1;
-
-            found = config_str.find(" ");
-            // Split line by spaces
-            while(found && found < str_size) {
-                found = config_str.find(" ");
-                // kernel names MUST be less than 128 chars, which is
-                // a length restricted by volk/volk_prefs.c
-                // on the last token in the parsed string we won't find a space
-                // so make sure we copy at most 128 chars.
-                if(found > 127) {
-                    found = 127;
-                }
-                str_size = config_str.size();
-                char buffer[128] = {'\0'};
-                config_str.copy(buffer, found + 1, 0);
-                buffer[found] = '\0';
-                single_kernel_result.push_back(std::string(buffer));
-                config_str.erase(0, found+1);
+            std::istringstream config_tokens(config_line);
+            volk_test_results_t kernel_result;
+            if(!(config_tokens >> kernel_result.name >> kernel_result.best_arch_a
+                 >> kernel_result.best_arch_u) || kernel_result.name.compare(0, 5, "volk_")) {
+                continue;
             }
+            kernel_result.config_name = kernel_result.name;
 
-            if(single_kernel_result.size() == 3) {
-                volk_test_results_t kernel_result;
-                kernel_result.name = std::string(single_kernel_result[0]);
-                kernel_result.config_name = std::string(single_kernel_result[0]);
-                kernel_result.best_arch_u = std::string(single_kernel_result[1]);
-                kernel_result.best_arch_a = std::string(single_kernel_result[2]);
-                results->push_back(kernel_result);
+            volk_test_bucket_t bucket;
+            while(kernel_result.buckets.size() < VOLK_MAX_LEN_BUCKETS &&
+                  config_tokens >> bucket.max_len >> bucket.best_arch_a >> bucket.best_arch_u) {
+                kernel_result.buckets.push_back(bucket);
             }
+            results->push_back(kernel_result);
         }
     }
 
@@ -319,6 +571,8 @@ void write_results(const std::vector<volk_test_results_t> *results, bool update_
         config << "\
 #this file is generated by volk_profile.\n\
 #the function name is followed by the preferred architecture.\n\
+#each following max_len aligned unaligned triple names the architecture\n\
+#to use for vectors shorter than max_len.\n\
 ";
     }
 
@@ -326,7 +580,14 @@ void write_results(const std::vector<volk_test_results_t> *results, bool update_
     for(profile_results = results->begin(); profile_results != results->end(); ++profile_results) {
         config << profile_results->config_name << " "
             << profile_results->best_arch_a << " "
-            << profile_results->best_arch_u << std::endl;
+            << profile_results->best_arch_u;
+        std::vector<volk_test_bucket_t>::const_iterator bucket;
+        for(bucket = profile_results->buckets.begin(); bucket != profile_results->buckets.end(); ++bucket) {
+            config << " " << bucket->max_len << " "
+                << bucket->best_arch_a << " "
+                << bucket->best_arch_u;
+        }
+        config << std::endl;
     }
     config.close();
 }
@@ -347,6 +608,14 @@ void write_json(std::ofstream &json_file, std::vector<volk_test_results_t> resul
             << "\"," << std::endl;
         json_file << "   \"best_arch_u\": \"" << result->best_arch_u
             << "\"," << std::endl;
+        json_file << "   \"buckets\": [";
+        for(size_t bi = 0; bi < result->buckets.size(); bi++) {
+            const volk_test_bucket_t &bucket = result->buckets[bi];
+            json_file << (bi? ", " : "") << "{\"max_len\": " << bucket.max_len
+                << ", \"best_arch_a\": \"" << bucket.best_arch_a
+                << "\", \"best_arch_u\": \"" << bucket.best_arch_u << "\"}";
+        }
+        json_file << "]," << std::endl;
         json_file << "   \"results\": {" << std::endl;
         size_t results_len = result->results.size();
         size_t ri = 0;
@@ -357,7 +626,33 @@ void write_json(std::ofstream &json_file, std::vector<volk_test_results_t> resul
             json_file << "    \"" << time.name << "\": {" << std::endl;
             json_file << "     \"name\": \"" << time.name << "\"," << std::endl;
             json_file << "     \"time\": " << time.time << "," << std::endl;
-            json_file << "     \"units\": \"" << time.units << "\"" << std::endl;
+            json_file << "     \"units\": \"" << time.units << "\"," << std::endl;
+            json_file << "     \"stats\": [" << std::endl;
+            for(size_t si = 0; si < time.stats.size(); si++) {
+                const volk_test_stats_t &stats = time.stats[si];
+                json_file << "      {\"vlen\": " << stats.vlen
+                    << ", \"iter\": " << stats.iter
+                    << ", \"residency\": \"" << volk_residency_name(stats.residency) << "\""
+                    << ", \"working_set_bytes\": " << stats.working_set
+                    << ", \"median_ns\": " << stats.median
+                    << ", \"p10_ns\": " << stats.p10
+                    << ", \"p90_ns\": " << stats.p90
+                    << ", \"ns_per_point\": " << stats.ns_per_point
+                    << ", \"gbps\": " << stats.gbps
+                    << ", \"counters\": {";
+                std::map<std::string, double>::const_iterator counter;
+                for(counter = stats.counters.begin(); counter != stats.counters.end(); ++counter) {
+                    json_file << (counter != stats.counters.begin()? ", " : "")
+                        << "\"" << counter->first << "\": " << counter->second;
+                }
+                json_file << "}"
+                    << ", \"trials_ns\": [";
+                for(size_t ti = 0; ti < stats.trials.size(); ti++) {
+                    json_file << (ti? ", " : "") << stats.trials[ti];
+                }
+                json_file << "]}" << (si+1 != time.stats.size()? "," : "") << std::endl;
+            }
+            json_file << "     ]" << std::endl;
             json_file << "    }" ;
             if(ri+1 != results_len) {
                 json_file << ",";
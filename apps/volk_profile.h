@@ -1,5 +1,16 @@
 
 
+std::vector<unsigned int> parse_vlens(const std::string &lens_str);
+void profile_test_case(volk_test_case_t test_case, const std::vector<unsigned int> &sweep_lens,
+    int def_vlen, std::vector<volk_test_results_t> *results, std::ostream &out);
+std::vector<int> pick_job_cpus(size_t jobs, bool no_smt);
+void run_parallel(const std::vector<volk_test_case_t> &selected, size_t jobs, bool no_smt,
+    const std::vector<unsigned int> &sweep_lens, int def_vlen,
+    std::vector<std::vector<volk_test_results_t> > *job_results);
+std::vector<volk_residency_t> parse_residencies(const std::string &names_str);
+std::vector<unsigned int> parse_sweep_lens(const std::string &lens_str, int vlen);
+void sweep_lengths(volk_test_case_t test_case, const std::vector<unsigned int> &lens,
+    volk_test_results_t *result, std::ostream &out);
 void read_results(std::vector<volk_test_results_t> *results);
 void read_results(std::vector<volk_test_results_t> *results, std::string path);
 void write_results(const std::vector<volk_test_results_t> *results, bool update_result);
@@ -124,6 +124,8 @@ class impl_class:
         self.deps = set(map(str.lower, re.findall('LV_HAVE_(\w+)', header)))
         #extract function suffix and args
         body = flatten_section_text(body)
+        #asm implementations are only declared here and linked from elsewhere
+        self.has_body = '{' in body
         try:
             fcn_matcher = re.compile('^.*(%s\\w*)\\s*\\((.*)$'%kern_name, re.DOTALL | re.MULTILINE)
             body = body.split('{')[0].rsplit(')', 1)[0] #get the part before the open ){ bracket
@@ -183,10 +185,18 @@ class kernel_class:
                 self._impls.remove(impl)
                 self.has_dispatcher = True
                 break
+        #the kernel may be split at any point: every pointer argument
+        #advances one element per point and no output spans points
+        self.peelable = re.search(r'#\s*define\s+%s_peelable\b'%self.name, code) is not None
         self.args = self._impls[0].args
         self.arglist_types = ', '.join([a[0] for a in self.args])
         self.arglist_full = ', '.join(['%s %s'%a for a in self.args])
         self.arglist_names = ', '.join([a[1] for a in self.args])
+        #the vector length used to pick a length bucket, if the kernel has one
+        self.len_arg = None
+        for arg_type, arg_name in self.args:
+            if arg_name == 'num_points' and arg_type.strip() == 'unsigned int':
+                self.len_arg = arg_name
 
     def get_impls(self, archs):
         archs = set(archs)
@@ -0,0 +1,154 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This file is intended to hold AVX2 and FMA intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-pasta.
+ */
+
+#ifndef INCLUDE_VOLK_VOLK_AVX2_FMA_INTRINSICS_H_
+#define INCLUDE_VOLK_VOLK_AVX2_FMA_INTRINSICS_H_
+#include <immintrin.h>
+
+static inline __m256
+_mm256_complexmul_fma_ps(__m256 x, __m256 y)
+{
+  __m256 yl, yh, tmp2;
+  yl = _mm256_moveldup_ps(y); // Load yl with cr,cr,dr,dr ...
+  yh = _mm256_movehdup_ps(y); // Load yh with ci,ci,di,di ...
+  tmp2 = _mm256_mul_ps(_mm256_permute_ps(x, 0xB1), yh); // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+  return _mm256_fmaddsub_ps(x, yl, tmp2); // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+}
+
+static inline __m256
+_mm256_complexconjugatemul_fma_ps(__m256 x, __m256 y)
+{
+  __m256 yl, yh, tmp2;
+  yl = _mm256_moveldup_ps(y); // Load yl with cr,cr,dr,dr ...
+  yh = _mm256_movehdup_ps(y); // Load yh with ci,ci,di,di ...
+  tmp2 = _mm256_mul_ps(_mm256_permute_ps(x, 0xB1), yh); // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+  return _mm256_fmsubadd_ps(x, yl, tmp2); // ar*cr+ai*ci, ai*cr-ar*ci, br*dr+bi*di, bi*dr-br*di
+}
+
+/*
+ * Sine and cosine of x from one range reduction, as _mm_sincos_ps in
+ * volk_sse41_intrinsics.h: x less the nearest multiple of pi/2, in three
+ * parts since the fused steps do not round q times each part, minimax
+ * polynomials on [-pi/4, pi/4], then the quadrant swaps and negates
+ * them. Within 2 ulp for |x| <= pi; up to |x| = 1e5 the absolute error
+ * stays below 1e-7.
+ */
+static inline void
+_mm256_sincos_fma_ps(__m256 x, __m256* sine, __m256* cosine)
+{
+  const __m256i ones = _mm256_set1_epi32(1);
+  const __m256i twos = _mm256_set1_epi32(2);
+  __m256 q, r, z, s, c, swap;
+  __m256i qi;
+
+  q = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(0.636619772367581343f)),
+                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  qi = _mm256_cvtps_epi32(q);
+  r = _mm256_fnmadd_ps(q, _mm256_set1_ps(1.5703125f), x);
+  r = _mm256_fnmadd_ps(q, _mm256_set1_ps(4.837512969970703125e-4f), r);
+  r = _mm256_fnmadd_ps(q, _mm256_set1_ps(7.54978995489188216e-8f), r);
+  z = _mm256_mul_ps(r, r);
+
+  s = _mm256_fmadd_ps(z, _mm256_set1_ps(-1.9515295891e-4f), _mm256_set1_ps(8.3321608736e-3f));
+  s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(-1.6666654611e-1f));
+  s = _mm256_fmadd_ps(_mm256_mul_ps(s, z), r, r);
+
+  c = _mm256_fmadd_ps(z, _mm256_set1_ps(2.443315711809948e-5f), _mm256_set1_ps(-1.388731625493765e-3f));
+  c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(4.166664568298827e-2f));
+  c = _mm256_fmadd_ps(_mm256_mul_ps(c, z), z, _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+  swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(qi, ones), ones));
+  *sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap),
+                        _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(qi, twos), 30)));
+  *cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap),
+                          _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(qi, ones), twos), 30)));
+}
+
+/*
+ * Arctangent of x. |x| is folded into [0, tan(pi/8)] by
+ * atan(a) = pi/4 + atan((a - 1) / (a + 1)) or pi/2 + atan(-1 / a),
+ * with a single division for whichever applies, and the minimax
+ * polynomial is evaluated there. Within 3 ulp over all finite x.
+ */
+static inline __m256
+_mm256_arctan_fma_ps(__m256 x)
+{
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  __m256 sign, a, big, mid, num, den, y, z, p;
+
+  sign = _mm256_and_ps(x, sign_mask);
+  a = _mm256_andnot_ps(sign_mask, x);
+  big = _mm256_cmp_ps(a, _mm256_set1_ps(2.414213562373095f), _CMP_GT_OQ);
+  mid = _mm256_cmp_ps(a, _mm256_set1_ps(0.4142135623730950f), _CMP_GT_OQ);
+
+  num = _mm256_blendv_ps(a, _mm256_sub_ps(a, one), mid);
+  num = _mm256_blendv_ps(num, _mm256_set1_ps(-1.0f), big);
+  den = _mm256_blendv_ps(one, _mm256_add_ps(a, one), mid);
+  den = _mm256_blendv_ps(den, a, big);
+  y = _mm256_and_ps(mid, _mm256_set1_ps(0.785398163397448309616f));
+  y = _mm256_blendv_ps(y, _mm256_set1_ps(1.57079632679489661923f), big);
+  a = _mm256_div_ps(num, den);
+
+  z = _mm256_mul_ps(a, a);
+  p = _mm256_fmadd_ps(z, _mm256_set1_ps(8.05374449538e-2f), _mm256_set1_ps(-1.38776856032e-1f));
+  p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.99777106478e-1f));
+  p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33329491539e-1f));
+  p = _mm256_fmadd_ps(_mm256_mul_ps(p, z), a, a);
+  return _mm256_xor_ps(_mm256_add_ps(y, p), sign);
+}
+
+/*
+ * Arcsine of x. For |x| > 1/2 it uses
+ * asin(a) = pi/2 - 2 asin(sqrt((1 - a) / 2)), so the minimax polynomial
+ * only ever sees arguments up to 1/2. Within 3 ulp on [-1, 1]; NaN
+ * outside it.
+ */
+static inline __m256
+_mm256_arcsin_fma_ps(__m256 x)
+{
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  __m256 sign, a, big, z, t, p;
+
+  sign = _mm256_and_ps(x, sign_mask);
+  a = _mm256_andnot_ps(sign_mask, x);
+  big = _mm256_cmp_ps(a, half, _CMP_GT_OQ);
+  z = _mm256_blendv_ps(_mm256_mul_ps(a, a), _mm256_fnmadd_ps(half, a, half), big);
+  t = _mm256_blendv_ps(a, _mm256_sqrt_ps(z), big);
+
+  p = _mm256_fmadd_ps(z, _mm256_set1_ps(4.2163199048e-2f), _mm256_set1_ps(2.4181311049e-2f));
+  p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(4.5470025998e-2f));
+  p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(7.4953002686e-2f));
+  p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.6666752422e-1f));
+  p = _mm256_fmadd_ps(_mm256_mul_ps(p, z), t, t);
+  p = _mm256_blendv_ps(p, _mm256_fnmadd_ps(_mm256_set1_ps(2.0f), p,
+                                           _mm256_set1_ps(1.57079632679489661923f)), big);
+  return _mm256_xor_ps(p, sign);
+}
+
+#endif /* INCLUDE_VOLK_VOLK_AVX2_FMA_INTRINSICS_H_ */
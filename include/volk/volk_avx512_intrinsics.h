@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This file is intended to hold AVX-512 intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-pasta.
+ */
+
+#ifndef INCLUDE_VOLK_VOLK_AVX512_INTRINSICS_H_
+#define INCLUDE_VOLK_VOLK_AVX512_INTRINSICS_H_
+#include <immintrin.h>
+
+/*
+ * Mask selecting the first n (0 <= n <= 16) float lanes of a register;
+ * used to load and store the tail of a vector without a scalar loop.
+ */
+static inline __mmask16
+_mm512_tailmask_ps(unsigned int n)
+{
+  return (__mmask16)((1u << n) - 1);
+}
+
+static inline __m512
+_mm512_complexmul_ps(__m512 x, __m512 y)
+{
+  __m512 yl, yh, tmp2;
+  yl = _mm512_moveldup_ps(y); // Load yl with cr,cr,dr,dr ...
+  yh = _mm512_movehdup_ps(y); // Load yh with ci,ci,di,di ...
+  x = _mm512_permute_ps(x, 0xB1); // Re-arrange x to be ai,ar,bi,br ...
+  tmp2 = _mm512_mul_ps(x, yh); // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+  x = _mm512_permute_ps(x, 0xB1); // Put x back to ar,ai,br,bi ...
+  return _mm512_fmaddsub_ps(x, yl, tmp2); // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+}
+
+static inline __m512
+_mm512_magnitudesquared_ps(__m512 cplxValue1, __m512 cplxValue2)
+{
+  const __m512i idx_real = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14,
+                                             16, 18, 20, 22, 24, 26, 28, 30);
+  const __m512i idx_imag = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15,
+                                             17, 19, 21, 23, 25, 27, 29, 31);
+  // Deinterleave the 16 complex values into real and imaginary parts
+  __m512 re = _mm512_permutex2var_ps(cplxValue1, idx_real, cplxValue2);
+  __m512 im = _mm512_permutex2var_ps(cplxValue1, idx_imag, cplxValue2);
+  return _mm512_fmadd_ps(re, re, _mm512_mul_ps(im, im)); // I^2 + Q^2
+}
+
+static inline __m512
+_mm512_complexnormalize_ps(__m512 x)
+{
+  __m512 tmp = _mm512_mul_ps(x, x); // ar*ar,ai*ai,br*br,bi*bi ...
+  tmp = _mm512_add_ps(tmp, _mm512_permute_ps(tmp, 0xB1)); // |a|^2,|a|^2,|b|^2,|b|^2 ...
+  return _mm512_div_ps(x, _mm512_sqrt_ps(tmp));
+}
+
+#endif /* INCLUDE_VOLK_VOLK_AVX512_INTRINSICS_H_ */
@@ -68,4 +68,11 @@ _mm256_magnitude_ps(__m256 cplxValue1, __m256 cplxValue2){
   return _mm256_sqrt_ps(_mm256_magnitudesquared_ps(cplxValue1, cplxValue2));
 }
 
+static inline __m256
+_mm256_complexnormalize_ps(__m256 x){
+  __m256 tmp = _mm256_mul_ps(x, x); // ar*ar,ai*ai,br*br,bi*bi ...
+  tmp = _mm256_add_ps(tmp, _mm256_permute_ps(tmp, 0xB1)); // |a|^2,|a|^2,|b|^2,|b|^2 ...
+  return _mm256_div_ps(x, _mm256_sqrt_ps(tmp));
+}
+
 #endif /* INCLUDE_VOLK_VOLK_AVX_INTRINSICS_H_ */
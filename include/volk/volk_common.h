@@ -19,6 +19,7 @@
 #    define __VOLK_ATTR_IMPORT
 #  endif
 #  define __VOLK_PREFETCH(addr)  __builtin_prefetch(addr)
+#  define __VOLK_THREAD_LOCAL    __thread
 #elif _MSC_VER
 #  define __VOLK_ATTR_ALIGNED(x) __declspec(align(x))
 #  define __VOLK_ATTR_UNUSED
@@ -27,6 +28,7 @@
 #  define __VOLK_ATTR_EXPORT     __declspec(dllexport)
 #  define __VOLK_ATTR_IMPORT     __declspec(dllimport)
 #  define __VOLK_PREFETCH(addr)
+#  define __VOLK_THREAD_LOCAL    __declspec(thread)
 #  define __VOLK_ASM __asm
 #  define __VOLK_VOLATILE
 #else
@@ -37,6 +39,7 @@
 #  define __VOLK_ATTR_EXPORT
 #  define __VOLK_ATTR_IMPORT
 #  define __VOLK_PREFETCH(addr)
+#  define __VOLK_THREAD_LOCAL    __thread
 #  define __VOLK_ASM __asm__
 #  define __VOLK_VOLATILE __volatile__
 #endif
@@ -0,0 +1,90 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_FFT_H
+#define INCLUDED_VOLK_FFT_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+
+__VOLK_DECL_BEGIN
+
+#define VOLK_FFT_MIN_SIZE 64
+#define VOLK_FFT_MAX_SIZE 65536
+
+typedef struct volk_fft_plan volk_fft_plan_t;
+
+/*!
+ * \brief Prepare a complex FFT of a power of two size.
+ *
+ * \details
+ * The plan holds the twiddles of every pass and two work buffers. Its
+ * transforms run volk_32fc_x2_fft_radix4_32fc once per pass, so the
+ * butterflies come from the machine the dispatcher picked. A plan
+ * must not execute on two threads at once; give each thread its own.
+ *
+ * \param fft_size A power of two from VOLK_FFT_MIN_SIZE to VOLK_FFT_MAX_SIZE.
+ * \param inverse Nonzero for the inverse transform (exp(+j...)), unscaled.
+ * \return the plan, or NULL for an unsupported size or out of memory.
+ */
+VOLK_API volk_fft_plan_t *volk_fft_plan_create(unsigned int fft_size, int inverse);
+
+/*!
+ * \brief Transform fft_size samples into their spectrum, in natural order.
+ * \param plan The plan from volk_fft_plan_create.
+ * \param out Receives fft_size bins; may be the same buffer as in.
+ * \param in The fft_size time samples.
+ */
+VOLK_API void volk_fft_execute(volk_fft_plan_t *plan, lv_32fc_t *out, const lv_32fc_t *in);
+
+/*!
+ * \brief Window, transform and take |X|^2 in one call.
+ *
+ * \details
+ * Computes out[k] = |FFT(in * window)[k]|^2 through the plan's own
+ * buffers, so a spectrum estimator needs neither a windowed copy nor
+ * the complex spectrum. The result is ready for
+ * volk_32f_s32f_calc_spectral_noise_floor_32f, averaging or a log
+ * conversion.
+ *
+ * \param plan The plan from volk_fft_plan_create.
+ * \param out Receives fft_size powers.
+ * \param in The fft_size time samples.
+ * \param window fft_size window coefficients, or NULL for none.
+ */
+VOLK_API void volk_fft_execute_power(volk_fft_plan_t *plan, float *out,
+                                     const lv_32fc_t *in, const float *window);
+
+/*!
+ * \brief The number of points the plan transforms.
+ */
+VOLK_API unsigned int volk_fft_plan_size(const volk_fft_plan_t *plan);
+
+/*!
+ * \brief Free a plan from volk_fft_plan_create.
+ * \param plan The plan, or NULL.
+ */
+VOLK_API void volk_fft_plan_destroy(volk_fft_plan_t *plan);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_FFT_H */
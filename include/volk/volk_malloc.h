@@ -61,6 +61,133 @@ VOLK_API void *volk_malloc(size_t size, size_t alignment);
  */
 VOLK_API void volk_free(void *aptr);
 
+/*!
+ * \brief Tells whether volk_malloc recycles blocks through its pool.
+ *
+ * \details
+ * With the pool, volk_malloc rounds requests up to a size class and
+ * volk_free keeps the blocks for reuse instead of returning them to the
+ * system, which makes allocate/free churn at block rate cheap. Build
+ * with -DENABLE_MALLOC_POOL=ON to use it by default, or set the
+ * environment variable VOLK_MALLOC_POOL to 1 or 0 to choose at run time.
+ *
+ * \return 1 if the pool is in use, 0 otherwise.
+ */
+VOLK_API int volk_malloc_is_pooled(void);
+
+//! Flags for volk_malloc_ex
+#define VOLK_MALLOC_DEFAULT     0x0
+//! Back the buffer with transparent huge pages (madvise MADV_HUGEPAGE)
+#define VOLK_MALLOC_HUGE_PAGES  0x1
+//! Back the buffer with explicit hugetlbfs pages (MAP_HUGETLB)
+#define VOLK_MALLOC_HUGE_TLB    0x2
+//! Fault every page in before returning
+#define VOLK_MALLOC_PREFAULT    0x4
+//! Return NULL rather than fall back to ordinary pages
+#define VOLK_MALLOC_NO_FALLBACK 0x8
+//! Place the pages on NUMA node \p node when they are first touched
+#define VOLK_MALLOC_NODE(node)  ((((unsigned int)(node)) + 1) << 16)
+#define VOLK_MALLOC_NODE_MASK   0xffff0000u
+#define VOLK_MALLOC_NODE_OF(flags) ((((flags) & VOLK_MALLOC_NODE_MASK) >> 16) - 1)
+
+/*!
+ * \brief Allocate a large buffer with control over how its pages are backed.
+ *
+ * \details
+ * Meant for long-lived sample buffers of many megabytes, where TLB
+ * misses and remote NUMA memory show up in profiles. The flags combine:
+ *
+ * - VOLK_MALLOC_HUGE_TLB maps explicit huge pages from the hugetlbfs
+ *   pool (vm.nr_hugepages); if none are free it falls back to
+ *   transparent huge pages, then to ordinary pages.
+ * - VOLK_MALLOC_HUGE_PAGES maps a huge page aligned region and asks the
+ *   kernel to back it with transparent huge pages.
+ * - VOLK_MALLOC_NODE(n) prefers NUMA node n for the pages; they are
+ *   placed there on first touch, whichever thread touches them.
+ * - VOLK_MALLOC_PREFAULT touches every page now, so the first pass over
+ *   the buffer does not pay for page faults.
+ * - VOLK_MALLOC_NO_FALLBACK returns NULL instead of falling back.
+ *
+ * Off Linux the flags other than VOLK_MALLOC_PREFAULT are not supported
+ * and the buffer comes from volk_malloc's system allocator. The buffer
+ * is at least 64 byte aligned; a mapped buffer starts on a boundary of
+ * the pages backing it. Release it with volk_free_ex, not volk_free.
+ *
+ * \param size The number of bytes to allocate.
+ * \param flags VOLK_MALLOC_* flags or'ed together.
+ * \return pointer to the buffer, or NULL on failure.
+ */
+VOLK_API void *volk_malloc_ex(size_t size, unsigned int flags);
+
+/*!
+ * \brief Free a buffer allocated by volk_malloc_ex.
+ * \param ptr The pointer volk_malloc_ex returned, or NULL.
+ */
+VOLK_API void volk_free_ex(void *ptr);
+
+/*!
+ * \brief The VOLK_MALLOC_* flags that took effect for a volk_malloc_ex buffer.
+ *
+ * \details
+ * Tells which requests fell back, e.g. VOLK_MALLOC_HUGE_TLB is missing
+ * when no explicit huge pages were free, and VOLK_MALLOC_HUGE_PAGES is
+ * there instead if transparent huge pages were granted. The node is reported when the
+ * kernel accepted the placement.
+ *
+ * \param ptr The pointer volk_malloc_ex returned.
+ * \return the flags that were applied.
+ */
+VOLK_API unsigned int volk_malloc_ex_flags(const void *ptr);
+
+/*!
+ * \brief Get \p size bytes of temporary memory aligned to \p alignment.
+ *
+ * \details
+ * Scratch buffers come from an arena owned by the calling thread. They
+ * stay valid until volk_scratch_release() is called with a mark taken
+ * before they were handed out, and must not be passed to volk_free or
+ * to another thread. Take a mark, get the buffers a call needs, and
+ * release the mark on the way out:
+ *
+ * \code
+ *   size_t mark = volk_scratch_mark();
+ *   float *tmp = (float *)volk_scratch_get(n * sizeof(float), volk_get_alignment());
+ *   ...
+ *   volk_scratch_release(mark);
+ * \endcode
+ *
+ * The arena keeps every chunk it grows, so a loop that needs the same
+ * buffers on every iteration does not allocate after the first one, even
+ * while an outer caller holds scratch memory of its own.
+ *
+ * \param size The number of bytes to get.
+ * \param alignment The byte alignment, a power of two.
+ * \return pointer to aligned memory, or NULL if it could not be allocated.
+ */
+VOLK_API void *volk_scratch_get(size_t size, size_t alignment);
+
+/*!
+ * \brief The current position of the calling thread's scratch arena.
+ * \return a mark for volk_scratch_release.
+ */
+VOLK_API size_t volk_scratch_mark(void);
+
+/*!
+ * \brief Give back every scratch buffer handed out since \p mark was taken.
+ * \param mark A mark from volk_scratch_mark in the same thread.
+ */
+VOLK_API void volk_scratch_release(size_t mark);
+
+/*!
+ * \brief Release all scratch buffers and free the calling thread's arena.
+ *
+ * \details
+ * The arena of a thread is freed when it exits where POSIX threads are
+ * available; elsewhere threads that used scratch memory should call this
+ * before they exit.
+ */
+VOLK_API void volk_scratch_free(void);
+
 __VOLK_DECL_END
 
 #endif /* INCLUDED_VOLK_MALLOC_H */
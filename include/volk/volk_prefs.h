@@ -6,6 +6,16 @@
 
 __VOLK_DECL_BEGIN
 
+//most length ranges a kernel may add in front of its default impls
+#define VOLK_MAX_LEN_BUCKETS 4
+
+typedef struct volk_arch_pref_bucket
+{
+    unsigned int max_len; //used when num_points < max_len
+    char impl_a[128];     //best aligned impl below max_len
+    char impl_u[128];     //best unaligned impl below max_len
+} volk_arch_pref_bucket_t;
+
 typedef struct volk_arch_pref
 {
     char name[128];   //name of the kernel
@@ -13,6 +23,16 @@ typedef struct volk_arch_pref
     char impl_u[128]; //best unaligned impl
 } volk_arch_pref_t;
 
+//volk_arch_pref_t plus the length ranges of its volk_config line
+typedef struct volk_arch_pref_ex
+{
+    char name[128];   //name of the kernel
+    char impl_a[128]; //best aligned impl
+    char impl_u[128]; //best unaligned impl
+    size_t n_buckets; //number of length ranges below
+    volk_arch_pref_bucket_t buckets[VOLK_MAX_LEN_BUCKETS]; //ascending max_len
+} volk_arch_pref_ex_t;
+
 ////////////////////////////////////////////////////////////////////////
 // get path to volk_config profiling info;
 // returns \0 in the argument on failure.
@@ -24,6 +44,21 @@ VOLK_API void volk_get_config_path(char *);
 ////////////////////////////////////////////////////////////////////////
 VOLK_API size_t volk_load_preferences(volk_arch_pref_t **);
 
+////////////////////////////////////////////////////////////////////////
+// load prefs like volk_load_preferences, keeping the length ranges
+////////////////////////////////////////////////////////////////////////
+VOLK_API size_t volk_load_preferences_ex(volk_arch_pref_ex_t **);
+
+////////////////////////////////////////////////////////////////////////
+// load prefs from the given volk_config file; each line reads
+//   name impl_a impl_u [max_len impl_a impl_u]...
+// where the optional triples, in ascending max_len, override the
+// default impls for calls with num_points < max_len; returns
+// VOLK_PREFS_UNREADABLE when the file cannot be opened
+////////////////////////////////////////////////////////////////////////
+#define VOLK_PREFS_UNREADABLE ((size_t)-1)
+VOLK_API size_t volk_load_preferences_from(const char *path, volk_arch_pref_ex_t **);
+
 __VOLK_DECL_END
 
 #endif //INCLUDED_VOLK_PREFS_H
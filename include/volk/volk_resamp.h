@@ -0,0 +1,41 @@
+/* -*- c -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_RESAMP_H
+#define INCLUDED_VOLK_RESAMP_H
+
+/*!
+ * \brief Resampler state, owned by the caller and carried across calls.
+ *
+ * \details
+ * Used by volk_32fc_32f_pfb_resamp_32fc; see that kernel for how the
+ * phase and index move.
+ */
+typedef struct{
+  float phase;          //filterbank branch of the next output, in [0, nfilts)
+  float phase_inc;      //branches per output: nfilts * input rate / output rate
+  unsigned int index;   //input sample the next output starts at
+  unsigned int nfilts;  //branches in the bank, which holds nfilts + 1 rows
+  unsigned int ntaps;   //taps per branch
+} volk_resamp_state_t;
+
+#endif /*INCLUDED_VOLK_RESAMP_H*/
@@ -0,0 +1,66 @@
+/* -*- c -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_RINGBUF_H
+#define INCLUDED_VOLK_RINGBUF_H
+
+#include <volk/volk_common.h>
+#include <stdlib.h>
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * \brief Allocate a circular buffer that is mapped twice, back to back.
+ *
+ * \details
+ * The same pages appear at ptr and at ptr + size, so for any offset
+ * below size the bytes from ptr + offset up to ptr + offset + size are
+ * contiguous and wrap around the ring. A stream can keep its history
+ * (FIR taps, correlator windows) in the ring and hand a VOLK kernel a
+ * plain pointer that reads across the wrap point, instead of copying
+ * the tail of one block to the head of the next. Writes through either
+ * mapping are seen through the other.
+ *
+ * The size is rounded up to a whole number of pages, which also makes
+ * it a multiple of every volk_get_alignment(). The buffer starts on a
+ * page boundary, so ptr + offset is aligned whenever offset is.
+ *
+ * Needs memfd_create on Linux or POSIX shared memory elsewhere; returns
+ * NULL where neither is available. A min_size above SIZE_MAX / 2 less
+ * one page fails with errno set to EINVAL.
+ *
+ * \param min_size The smallest ring size in bytes.
+ * \param size Receives the ring size actually mapped.
+ * \return pointer to the first mapping, or NULL on failure.
+ */
+VOLK_API void *volk_ringbuf_alloc(size_t min_size, size_t *size);
+
+/*!
+ * \brief Unmap a circular buffer from volk_ringbuf_alloc.
+ * \param ptr The pointer volk_ringbuf_alloc returned, or NULL.
+ * \param size The size volk_ringbuf_alloc reported.
+ */
+VOLK_API void volk_ringbuf_free(void *ptr, size_t size);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_RINGBUF_H */
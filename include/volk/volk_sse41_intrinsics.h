@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This file is intended to hold SSE4.1 intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-pasta.
+ */
+
+#ifndef INCLUDE_VOLK_VOLK_SSE41_INTRINSICS_H_
+#define INCLUDE_VOLK_VOLK_SSE41_INTRINSICS_H_
+#include <smmintrin.h>
+
+/*
+ * Sine and cosine of x from one range reduction. x is brought into
+ * [-pi/4, pi/4] by subtracting the nearest multiple q of pi/2 in four
+ * parts (Cody-Waite); the quadrant q then swaps and negates the two
+ * minimax polynomials. The first two parts have 8 significant bits, so
+ * their products with q are exact without FMA for |q| < 2^16. The error
+ * is within 2 ulp for |x| <= pi, and the absolute error stays below
+ * 1e-7 for |x| up to 1e5.
+ */
+static inline void
+_mm_sincos_ps(__m128 x, __m128* sine, __m128* cosine)
+{
+  const __m128 two_over_pi = _mm_set1_ps(0.636619772367581343f);
+  const __m128 pio2_1 = _mm_set1_ps(1.5703125f);
+  const __m128 pio2_2 = _mm_set1_ps(4.825592041015625e-4f);
+  const __m128 pio2_3 = _mm_set1_ps(1.2675908465098473e-6f);
+  const __m128 pio2_4 = _mm_set1_ps(-5.1453114636784356e-14f);
+  const __m128i ones = _mm_set1_epi32(1);
+  const __m128i twos = _mm_set1_epi32(2);
+  __m128 q, r, z, s, c, swap;
+  __m128i qi;
+
+  q = _mm_round_ps(_mm_mul_ps(x, two_over_pi), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  qi = _mm_cvtps_epi32(q);
+  r = _mm_sub_ps(x, _mm_mul_ps(q, pio2_1));
+  r = _mm_sub_ps(r, _mm_mul_ps(q, pio2_2));
+  r = _mm_sub_ps(r, _mm_mul_ps(q, pio2_3));
+  r = _mm_sub_ps(r, _mm_mul_ps(q, pio2_4));
+  z = _mm_mul_ps(r, r);
+
+  s = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(-1.9515295891e-4f)), _mm_set1_ps(8.3321608736e-3f));
+  s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+  s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), r), r);
+
+  c = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(2.443315711809948e-5f)), _mm_set1_ps(-1.388731625493765e-3f));
+  c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+  c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+  c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+  // odd quadrants swap sine and cosine; bit 1 of q (of q + 1) negates the sine (cosine)
+  swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(qi, ones), ones));
+  *sine = _mm_xor_ps(_mm_blendv_ps(s, c, swap),
+                     _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(qi, twos), 30)));
+  *cosine = _mm_xor_ps(_mm_blendv_ps(c, s, swap),
+                       _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(qi, ones), twos), 30)));
+}
+
+#endif /* INCLUDE_VOLK_VOLK_SSE41_INTRINSICS_H_ */
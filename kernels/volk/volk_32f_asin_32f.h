@@ -27,6 +27,8 @@
  *
  * Computes arcsine of input vector and stores results in output vector.
  *
+ * The AVX2+FMA versions are within 3 ulp on [-1, 1].
+ *
  * <b>Dispatcher Prototype</b>
  * \code
  * void volk_32f_asin_32f(float* bVector, const float* aVector, unsigned int num_points)
@@ -139,6 +141,35 @@ volk_32f_asin_32f_a_sse4_1(float* bVector, const float* aVector, unsigned int nu
 
 #endif /* LV_HAVE_SSE4_1 for aligned */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_asin_32f_a_avx2_fma(float* bVector, const float* aVector, unsigned int num_points)
+{
+  float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  unsigned int eighthPoints = num_points / 8;
+  __m256 aVal;
+
+  for(;number < eighthPoints; number++){
+    aVal = _mm256_load_ps(aPtr);
+    _mm256_store_ps(bPtr, _mm256_arcsin_fma_ps(aVal));
+    aPtr += 8;
+    bPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *bPtr++ = asin(*aPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
 #endif /* INCLUDED_volk_32f_asin_32f_a_H */
 
 #ifndef INCLUDED_volk_32f_asin_32f_u_H
@@ -206,6 +237,35 @@ volk_32f_asin_32f_u_sse4_1(float* bVector, const float* aVector, unsigned int nu
 
 #endif /* LV_HAVE_SSE4_1 for unaligned */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_asin_32f_u_avx2_fma(float* bVector, const float* aVector, unsigned int num_points)
+{
+  float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  unsigned int eighthPoints = num_points / 8;
+  __m256 aVal;
+
+  for(;number < eighthPoints; number++){
+    aVal = _mm256_loadu_ps(aPtr);
+    _mm256_storeu_ps(bPtr, _mm256_arcsin_fma_ps(aVal));
+    aPtr += 8;
+    bPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *bPtr++ = asin(*aPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
 #ifdef LV_HAVE_GENERIC
 
 static inline void
@@ -71,6 +71,8 @@
 #ifndef INCLUDED_volk_32f_s32f_power_32f_a_H
 #define INCLUDED_volk_32f_s32f_power_32f_a_H
 
+#define volk_32f_s32f_power_32f_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 #include <math.h>
@@ -27,6 +27,10 @@
  *
  * Computes the sine of the input vector and stores the results in the output vector.
  *
+ * The AVX2+FMA versions are within 2 ulp for |x| <= pi. Up to |x| = 1e5
+ * their absolute error stays below 1e-7, so the error in ulp grows
+ * near the zeros of the sine.
+ *
  * <b>Dispatcher Prototype</b>
  * \code
  * void volk_32f_sin_32f(float* bVector, const float* aVector, unsigned int num_points)
@@ -153,6 +157,36 @@ volk_32f_sin_32f_a_sse4_1(float* bVector, const float* aVector, unsigned int num
 #endif /* LV_HAVE_SSE4_1 for aligned */
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_sin_32f_a_avx2_fma(float* bVector, const float* aVector, unsigned int num_points)
+{
+  float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  unsigned int eighthPoints = num_points / 8;
+  __m256 aVal, sine, cosine;
+
+  for(;number < eighthPoints; number++){
+    aVal = _mm256_load_ps(aPtr);
+    _mm256_sincos_fma_ps(aVal, &sine, &cosine);
+    _mm256_store_ps(bPtr, sine);
+    aPtr += 8;
+    bPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *bPtr++ = sin(*aPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
 #endif /* INCLUDED_volk_32f_sin_32f_a_H */
 
 #ifndef INCLUDED_volk_32f_sin_32f_u_H
@@ -233,6 +267,36 @@ volk_32f_sin_32f_u_sse4_1(float* bVector, const float* aVector, unsigned int num
 #endif /* LV_HAVE_SSE4_1 for unaligned */
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_sin_32f_u_avx2_fma(float* bVector, const float* aVector, unsigned int num_points)
+{
+  float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  unsigned int eighthPoints = num_points / 8;
+  __m256 aVal, sine, cosine;
+
+  for(;number < eighthPoints; number++){
+    aVal = _mm256_loadu_ps(aPtr);
+    _mm256_sincos_fma_ps(aVal, &sine, &cosine);
+    _mm256_storeu_ps(bPtr, sine);
+    aPtr += 8;
+    bPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *bPtr++ = sin(*aPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
 #ifdef LV_HAVE_GENERIC
 
 static inline void
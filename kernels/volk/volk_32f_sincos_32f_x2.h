@@ -0,0 +1,203 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*!
+ * \page volk_32f_sincos_32f_x2
+ *
+ * \b Overview
+ *
+ * Computes the sine and the cosine of each input from a single range
+ * reduction, which is cheaper than volk_32f_sin_32f and
+ * volk_32f_cos_32f one after the other. The SIMD versions are within 2
+ * ulp for |x| <= pi, and within 1e-7 absolute for |x| up to 1e5.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_32f_sincos_32f_x2(float* sinVector, float* cosVector, const float* inVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector: The angles in radians.
+ * \li num_points: The number of data points.
+ *
+ * \b Outputs
+ * \li sinVector: The sines.
+ * \li cosVector: The cosines.
+ *
+ * \b Example
+ * \code
+ *   int N = 10;
+ *   unsigned int alignment = volk_get_alignment();
+ *   float* in = (float*)volk_malloc(sizeof(float)*N, alignment);
+ *   float* s = (float*)volk_malloc(sizeof(float)*N, alignment);
+ *   float* c = (float*)volk_malloc(sizeof(float)*N, alignment);
+ *
+ *   for(unsigned int ii = 0; ii < N; ++ii){
+ *       in[ii] = 3.14159265f * ii / N;
+ *   }
+ *
+ *   volk_32f_sincos_32f_x2(s, c, in, N);
+ *
+ *   for(unsigned int ii = 0; ii < N; ++ii){
+ *       printf("sin(%1.3f) = %1.3f, cos(%1.3f) = %1.3f\n", in[ii], s[ii], in[ii], c[ii]);
+ *   }
+ *
+ *   volk_free(in);
+ *   volk_free(s);
+ *   volk_free(c);
+ * \endcode
+ */
+
+#include <math.h>
+
+#ifndef INCLUDED_volk_32f_sincos_32f_x2_a_H
+#define INCLUDED_volk_32f_sincos_32f_x2_a_H
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+#include <volk/volk_sse41_intrinsics.h>
+
+static inline void
+volk_32f_sincos_32f_x2_a_sse4_1(float* sinVector, float* cosVector, const float* inVector,
+                                unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  __m128 s, c;
+
+  for(; number < quarterPoints; number++){
+    _mm_sincos_ps(_mm_load_ps(inVector + 4 * number), &s, &c);
+    _mm_store_ps(sinVector + 4 * number, s);
+    _mm_store_ps(cosVector + 4 * number, c);
+  }
+
+  for(number = quarterPoints * 4; number < num_points; number++){
+    sinVector[number] = sinf(inVector[number]);
+    cosVector[number] = cosf(inVector[number]);
+  }
+}
+
+#endif /* LV_HAVE_SSE4_1 for aligned */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_sincos_32f_x2_a_avx2_fma(float* sinVector, float* cosVector, const float* inVector,
+                                  unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+  __m256 s, c;
+
+  for(; number < eighthPoints; number++){
+    _mm256_sincos_fma_ps(_mm256_load_ps(inVector + 8 * number), &s, &c);
+    _mm256_store_ps(sinVector + 8 * number, s);
+    _mm256_store_ps(cosVector + 8 * number, c);
+  }
+
+  for(number = eighthPoints * 8; number < num_points; number++){
+    sinVector[number] = sinf(inVector[number]);
+    cosVector[number] = cosf(inVector[number]);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
+#endif /* INCLUDED_volk_32f_sincos_32f_x2_a_H */
+
+
+#ifndef INCLUDED_volk_32f_sincos_32f_x2_u_H
+#define INCLUDED_volk_32f_sincos_32f_x2_u_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_32f_sincos_32f_x2_generic(float* sinVector, float* cosVector, const float* inVector,
+                               unsigned int num_points)
+{
+  unsigned int number;
+  for(number = 0; number < num_points; number++){
+    sinVector[number] = sinf(inVector[number]);
+    cosVector[number] = cosf(inVector[number]);
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+#include <volk/volk_sse41_intrinsics.h>
+
+static inline void
+volk_32f_sincos_32f_x2_u_sse4_1(float* sinVector, float* cosVector, const float* inVector,
+                                unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+  __m128 s, c;
+
+  for(; number < quarterPoints; number++){
+    _mm_sincos_ps(_mm_loadu_ps(inVector + 4 * number), &s, &c);
+    _mm_storeu_ps(sinVector + 4 * number, s);
+    _mm_storeu_ps(cosVector + 4 * number, c);
+  }
+
+  for(number = quarterPoints * 4; number < num_points; number++){
+    sinVector[number] = sinf(inVector[number]);
+    cosVector[number] = cosf(inVector[number]);
+  }
+}
+
+#endif /* LV_HAVE_SSE4_1 for unaligned */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_sincos_32f_x2_u_avx2_fma(float* sinVector, float* cosVector, const float* inVector,
+                                  unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+  __m256 s, c;
+
+  for(; number < eighthPoints; number++){
+    _mm256_sincos_fma_ps(_mm256_loadu_ps(inVector + 8 * number), &s, &c);
+    _mm256_storeu_ps(sinVector + 8 * number, s);
+    _mm256_storeu_ps(cosVector + 8 * number, c);
+  }
+
+  for(number = eighthPoints * 8; number < num_points; number++){
+    sinVector[number] = sinf(inVector[number]);
+    cosVector[number] = cosf(inVector[number]);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
+#endif /* INCLUDED_volk_32f_sincos_32f_x2_u_H */
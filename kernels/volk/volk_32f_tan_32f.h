@@ -29,6 +29,9 @@
  *
  * b[i] = tan(a[i])
  *
+ * The AVX2+FMA versions divide the sine by the cosine from one range
+ * reduction and are within 4 ulp for |x| <= pi.
+ *
  * <b>Dispatcher Prototype</b>
  * \code
  * void volk_32f_tan_32f(float* bVector, const float* aVector, unsigned int num_points)
@@ -159,6 +162,36 @@ volk_32f_tan_32f_a_sse4_1(float* bVector, const float* aVector,
 #endif /* LV_HAVE_SSE4_1 for aligned */
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_tan_32f_a_avx2_fma(float* bVector, const float* aVector, unsigned int num_points)
+{
+  float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  unsigned int eighthPoints = num_points / 8;
+  __m256 aVal, sine, cosine;
+
+  for(;number < eighthPoints; number++){
+    aVal = _mm256_load_ps(aPtr);
+    _mm256_sincos_fma_ps(aVal, &sine, &cosine);
+    _mm256_store_ps(bPtr, _mm256_div_ps(sine, cosine));
+    aPtr += 8;
+    bPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *bPtr++ = tan(*aPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
 #endif /* INCLUDED_volk_32f_tan_32f_a_H */
 
 #ifndef INCLUDED_volk_32f_tan_32f_u_H
@@ -244,6 +277,36 @@ volk_32f_tan_32f_u_sse4_1(float* bVector, const float* aVector, unsigned int num
 #endif /* LV_HAVE_SSE4_1 for unaligned */
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32f_tan_32f_u_avx2_fma(float* bVector, const float* aVector, unsigned int num_points)
+{
+  float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  unsigned int eighthPoints = num_points / 8;
+  __m256 aVal, sine, cosine;
+
+  for(;number < eighthPoints; number++){
+    aVal = _mm256_loadu_ps(aPtr);
+    _mm256_sincos_fma_ps(aVal, &sine, &cosine);
+    _mm256_storeu_ps(bPtr, _mm256_div_ps(sine, cosine));
+    aPtr += 8;
+    bPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *bPtr++ = tan(*aPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
 #ifdef LV_HAVE_GENERIC
 
 static inline void
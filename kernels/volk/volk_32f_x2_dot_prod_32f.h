@@ -359,6 +359,40 @@ static inline void volk_32f_x2_dot_prod_32f_u_avx( float* result, const  float*
 
 #endif /*LV_HAVE_AVX*/
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void volk_32f_x2_dot_prod_32f_u_avx512f(float * result, const float * input, const float* taps, unsigned int num_points){
+  unsigned int number;
+  const unsigned int sixteenthPoints = num_points / 16;
+
+  const float* aPtr = input;
+  const float* bPtr = taps;
+
+  __m512 dotProdVal = _mm512_setzero_ps();
+  __m512 aVal1, bVal1;
+
+  for (number = 0; number < sixteenthPoints; number++ ) {
+
+    aVal1 = _mm512_loadu_ps(aPtr);
+    bVal1 = _mm512_loadu_ps(bPtr);
+    aPtr += 16;
+    bPtr += 16;
+
+    dotProdVal = _mm512_fmadd_ps(aVal1, bVal1, dotProdVal);
+  }
+
+  // Masked-off lanes load as zero and do not contribute to the sum
+  const __mmask16 tailMask = _mm512_tailmask_ps(num_points % 16);
+  aVal1 = _mm512_maskz_loadu_ps(tailMask, aPtr);
+  bVal1 = _mm512_maskz_loadu_ps(tailMask, bPtr);
+  dotProdVal = _mm512_fmadd_ps(aVal1, bVal1, dotProdVal);
+
+  *result = _mm512_reduce_add_ps(dotProdVal);
+}
+#endif /* LV_HAVE_AVX512F */
+
 #endif /*INCLUDED_volk_32f_x2_dot_prod_32f_u_H*/
 #ifndef INCLUDED_volk_32f_x2_dot_prod_32f_a_H
 #define INCLUDED_volk_32f_x2_dot_prod_32f_a_H
@@ -691,6 +725,41 @@ static inline void volk_32f_x2_dot_prod_32f_a_avx2_fma(float * result, const flo
 #endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
 
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void volk_32f_x2_dot_prod_32f_a_avx512f(float * result, const float * input, const float* taps, unsigned int num_points){
+  unsigned int number;
+  const unsigned int sixteenthPoints = num_points / 16;
+
+  const float* aPtr = input;
+  const float* bPtr = taps;
+
+  __m512 dotProdVal = _mm512_setzero_ps();
+  __m512 aVal1, bVal1;
+
+  for (number = 0; number < sixteenthPoints; number++ ) {
+
+    aVal1 = _mm512_load_ps(aPtr);
+    bVal1 = _mm512_load_ps(bPtr);
+    aPtr += 16;
+    bPtr += 16;
+
+    dotProdVal = _mm512_fmadd_ps(aVal1, bVal1, dotProdVal);
+  }
+
+  // Masked-off lanes load as zero and do not contribute to the sum
+  const __mmask16 tailMask = _mm512_tailmask_ps(num_points % 16);
+  aVal1 = _mm512_maskz_load_ps(tailMask, aPtr);
+  bVal1 = _mm512_maskz_load_ps(tailMask, bPtr);
+  dotProdVal = _mm512_fmadd_ps(aVal1, bVal1, dotProdVal);
+
+  *result = _mm512_reduce_add_ps(dotProdVal);
+}
+#endif /* LV_HAVE_AVX512F */
+
+
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
 
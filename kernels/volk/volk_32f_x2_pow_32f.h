@@ -29,6 +29,11 @@
  *
  * c[i] = pow(a[i], b[i])
  *
+ * The SIMD versions compute exp(b * ln(a)) and expect positive bases.
+ * The AVX2+FMA versions are within 2 ulp while |b ln(a)| <= 1. Beyond
+ * that the error of ln(a) is scaled up by b, reaching about 75 ulp at
+ * |b ln(a)| = 46.
+ *
  * <b>Dispatcher Prototype</b>
  * \code
  * void volk_32f_x2_pow_32f(float* cVector, const float* bVector, const float* aVector, unsigned int num_points)
@@ -196,6 +201,96 @@ volk_32f_x2_pow_32f_a_sse4_1(float* cVector, const float* bVector,
 
 #endif /* LV_HAVE_SSE4_1 for aligned */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+
+static inline void
+volk_32f_x2_pow_32f_a_avx2_fma(float* cVector, const float* bVector,
+                               const float* aVector, unsigned int num_points)
+{
+  float* cPtr = cVector;
+  const float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+
+  __m256 aVal, bVal, cVal, mantissa, exponent, small, logarithm, z, y, fx;
+  __m256i bits;
+
+  const __m256 one = _mm256_set1_ps(1.0);
+  const __m256 half = _mm256_set1_ps(0.5);
+  const __m256 sqrthf = _mm256_set1_ps(0.707106781186547524);
+  const __m256 log_q1 = _mm256_set1_ps(-2.12194440e-4);
+  const __m256 log_q2 = _mm256_set1_ps(0.693359375);
+  const __m256 exp_hi = _mm256_set1_ps(88.3762626647949);
+  const __m256 exp_lo = _mm256_set1_ps(-88.3762626647949);
+  const __m256 log2EF = _mm256_set1_ps(1.44269504088896341);
+  const __m256 exp_C1 = _mm256_set1_ps(0.693359375);
+  const __m256 exp_C2 = _mm256_set1_ps(-2.12194440e-4);
+  const __m256i pi32_0x7f = _mm256_set1_epi32(0x7f);
+
+  for(;number < eighthPoints; number++){
+    // ln(a) = e ln(2) + ln(m), with the mantissa m in [sqrt(1/2), sqrt(2))
+    aVal = _mm256_load_ps(aPtr);
+    bits = _mm256_castps_si256(aVal);
+    exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7f800000)), 23),
+                                                   _mm256_set1_epi32(126)));
+    mantissa = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+                                                   _mm256_set1_epi32(0x3f000000)));
+    small = _mm256_cmp_ps(mantissa, sqrthf, _CMP_LT_OQ);
+    exponent = _mm256_sub_ps(exponent, _mm256_and_ps(one, small));
+    mantissa = _mm256_sub_ps(_mm256_add_ps(mantissa, _mm256_and_ps(mantissa, small)), one);
+
+    z = _mm256_mul_ps(mantissa, mantissa);
+    y = _mm256_fmadd_ps(mantissa, _mm256_set1_ps(7.0376836292e-2), _mm256_set1_ps(-1.1514610310e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(1.1676998740e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(-1.2420140846e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(1.4249322787e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(-1.6668057665e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(2.0000714765e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(-2.4999993993e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(3.3333331174e-1));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, mantissa), z);
+    y = _mm256_fmadd_ps(exponent, log_q1, y);
+    y = _mm256_fnmadd_ps(z, half, y);
+    logarithm = _mm256_fmadd_ps(exponent, log_q2, _mm256_add_ps(mantissa, y));
+
+    // Now calculate b*lna
+    bVal = _mm256_load_ps(bPtr);
+    bVal = _mm256_mul_ps(bVal, logarithm);
+
+    // Now compute exp(b*lna)
+    bVal = _mm256_max_ps(_mm256_min_ps(bVal, exp_hi), exp_lo);
+    fx = _mm256_floor_ps(_mm256_fmadd_ps(bVal, log2EF, half));
+    bVal = _mm256_fnmadd_ps(fx, exp_C1, bVal);
+    bVal = _mm256_fnmadd_ps(fx, exp_C2, bVal);
+    z = _mm256_mul_ps(bVal, bVal);
+
+    y = _mm256_fmadd_ps(bVal, _mm256_set1_ps(1.9875691500e-4), _mm256_set1_ps(1.3981999507e-3));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(8.3334519073e-3));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(4.1665795894e-2));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(1.6666665459e-1));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(5.0000001201e-1));
+    y = _mm256_add_ps(_mm256_fmadd_ps(y, z, bVal), one);
+
+    cVal = _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), pi32_0x7f), 23)));
+
+    _mm256_store_ps(cPtr, cVal);
+
+    aPtr += 8;
+    bPtr += 8;
+    cPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *cPtr++ = powf(*aPtr++, *bPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
 #endif /* INCLUDED_volk_32f_x2_pow_32f_a_H */
 
 
@@ -332,4 +427,94 @@ volk_32f_x2_pow_32f_u_sse4_1(float* cVector, const float* bVector,
 
 #endif /* LV_HAVE_SSE4_1 for unaligned */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+
+static inline void
+volk_32f_x2_pow_32f_u_avx2_fma(float* cVector, const float* bVector,
+                               const float* aVector, unsigned int num_points)
+{
+  float* cPtr = cVector;
+  const float* bPtr = bVector;
+  const float* aPtr = aVector;
+
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+
+  __m256 aVal, bVal, cVal, mantissa, exponent, small, logarithm, z, y, fx;
+  __m256i bits;
+
+  const __m256 one = _mm256_set1_ps(1.0);
+  const __m256 half = _mm256_set1_ps(0.5);
+  const __m256 sqrthf = _mm256_set1_ps(0.707106781186547524);
+  const __m256 log_q1 = _mm256_set1_ps(-2.12194440e-4);
+  const __m256 log_q2 = _mm256_set1_ps(0.693359375);
+  const __m256 exp_hi = _mm256_set1_ps(88.3762626647949);
+  const __m256 exp_lo = _mm256_set1_ps(-88.3762626647949);
+  const __m256 log2EF = _mm256_set1_ps(1.44269504088896341);
+  const __m256 exp_C1 = _mm256_set1_ps(0.693359375);
+  const __m256 exp_C2 = _mm256_set1_ps(-2.12194440e-4);
+  const __m256i pi32_0x7f = _mm256_set1_epi32(0x7f);
+
+  for(;number < eighthPoints; number++){
+    // ln(a) = e ln(2) + ln(m), with the mantissa m in [sqrt(1/2), sqrt(2))
+    aVal = _mm256_loadu_ps(aPtr);
+    bits = _mm256_castps_si256(aVal);
+    exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7f800000)), 23),
+                                                   _mm256_set1_epi32(126)));
+    mantissa = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+                                                   _mm256_set1_epi32(0x3f000000)));
+    small = _mm256_cmp_ps(mantissa, sqrthf, _CMP_LT_OQ);
+    exponent = _mm256_sub_ps(exponent, _mm256_and_ps(one, small));
+    mantissa = _mm256_sub_ps(_mm256_add_ps(mantissa, _mm256_and_ps(mantissa, small)), one);
+
+    z = _mm256_mul_ps(mantissa, mantissa);
+    y = _mm256_fmadd_ps(mantissa, _mm256_set1_ps(7.0376836292e-2), _mm256_set1_ps(-1.1514610310e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(1.1676998740e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(-1.2420140846e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(1.4249322787e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(-1.6668057665e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(2.0000714765e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(-2.4999993993e-1));
+    y = _mm256_fmadd_ps(y, mantissa, _mm256_set1_ps(3.3333331174e-1));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, mantissa), z);
+    y = _mm256_fmadd_ps(exponent, log_q1, y);
+    y = _mm256_fnmadd_ps(z, half, y);
+    logarithm = _mm256_fmadd_ps(exponent, log_q2, _mm256_add_ps(mantissa, y));
+
+    // Now calculate b*lna
+    bVal = _mm256_loadu_ps(bPtr);
+    bVal = _mm256_mul_ps(bVal, logarithm);
+
+    // Now compute exp(b*lna)
+    bVal = _mm256_max_ps(_mm256_min_ps(bVal, exp_hi), exp_lo);
+    fx = _mm256_floor_ps(_mm256_fmadd_ps(bVal, log2EF, half));
+    bVal = _mm256_fnmadd_ps(fx, exp_C1, bVal);
+    bVal = _mm256_fnmadd_ps(fx, exp_C2, bVal);
+    z = _mm256_mul_ps(bVal, bVal);
+
+    y = _mm256_fmadd_ps(bVal, _mm256_set1_ps(1.9875691500e-4), _mm256_set1_ps(1.3981999507e-3));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(8.3334519073e-3));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(4.1665795894e-2));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(1.6666665459e-1));
+    y = _mm256_fmadd_ps(y, bVal, _mm256_set1_ps(5.0000001201e-1));
+    y = _mm256_add_ps(_mm256_fmadd_ps(y, z, bVal), one);
+
+    cVal = _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), pi32_0x7f), 23)));
+
+    _mm256_storeu_ps(cPtr, cVal);
+
+    aPtr += 8;
+    bPtr += 8;
+    cPtr += 8;
+  }
+
+  number = eighthPoints * 8;
+  for(;number < num_points; number++){
+    *cPtr++ = powf(*aPtr++, *bPtr++);
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
 #endif /* INCLUDED_volk_32f_x2_log2_32f_u_H */
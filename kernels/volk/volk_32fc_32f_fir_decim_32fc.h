@@ -0,0 +1,454 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*!
+ * \page volk_32fc_32f_fir_decim_32fc
+ *
+ * \b Overview
+ *
+ * Filters complex samples with real taps and keeps every \p decim-th
+ * output. Output k is the dot product of \p taps with the \p ntaps
+ * samples starting at input[k * decim], so the taps are stored
+ * time-reversed with respect to the impulse response. This replaces one
+ * volk_32fc_32f_dot_prod_32fc call per output: the SIMD versions widen
+ * a block of taps into the complex lane layout once per call and keep
+ * it in registers while they sweep all outputs.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_32fc_32f_fir_decim_32fc(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int ntaps, unsigned int decim, unsigned int num_out)
+ * \endcode
+ *
+ * \b Inputs
+ * \li in: complex samples, at least (num_out - 1) * decim + ntaps of them
+ * \li taps: the time-reversed real filter taps
+ * \li ntaps: number of taps
+ * \li decim: the decimation factor, at least 1
+ * \li num_out: number of outputs to compute
+ *
+ * \b Outputs
+ * \li out: num_out filtered and decimated samples
+ *
+ * \b Example
+ * A 4x decimating low pass filter over a block of samples.
+ * \code
+ * unsigned int ntaps = 32, decim = 4, num_out = 1024;
+ * unsigned int num_in = (num_out - 1) * decim + ntaps;
+ * lv_32fc_t* in = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t)*num_in, volk_get_alignment());
+ * lv_32fc_t* out = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t)*num_out, volk_get_alignment());
+ * float* taps = (float*)volk_malloc(sizeof(float)*ntaps, volk_get_alignment());
+ *
+ * <populate in, and taps with the reversed impulse response>
+ *
+ * volk_32fc_32f_fir_decim_32fc(out, in, taps, ntaps, decim, num_out);
+ *
+ * volk_free(in);
+ * volk_free(out);
+ * volk_free(taps);
+ * \endcode
+ */
+
+#ifndef INCLUDED_volk_32fc_32f_fir_decim_32fc_u_H
+#define INCLUDED_volk_32fc_32f_fir_decim_32fc_u_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+
+//out[k] = the taps from first on; the SIMD versions add the rest to it
+static inline void
+fir_decim_32fc_tail(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                    unsigned int first, unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  unsigned int k, j;
+  for(k = 0; k < num_out; k++){
+    const float* inPtr = (const float*)(in + k * decim);
+    float re = 0.0f, im = 0.0f;
+    for(j = first; j < ntaps; j++){
+      re += inPtr[2 * j] * taps[j];
+      im += inPtr[2 * j + 1] * taps[j];
+    }
+    out[k] = lv_cmake(re, im);
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                     unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  fir_decim_32fc_tail(out, in, taps, 0, ntaps, decim, num_out);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_u_sse(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                   unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  const unsigned int pairs = ntaps / 2;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  unsigned int p = 0, k;
+  __m128 t, t0, t1, t2, t3, acc0, acc1;
+
+  fir_decim_32fc_tail(out, in, taps, pairs * 2, ntaps, decim, num_out);
+
+  //taps t0|t0|t1|t1 in the complex lanes, kept in registers for all outputs
+  for(; p + 4 <= pairs; p += 4){
+    t = _mm_loadu_ps(taps + 2 * p);
+    t0 = _mm_unpacklo_ps(t, t);
+    t1 = _mm_unpackhi_ps(t, t);
+    t = _mm_loadu_ps(taps + 2 * p + 4);
+    t2 = _mm_unpacklo_ps(t, t);
+    t3 = _mm_unpackhi_ps(t, t);
+    for(k = 0; k < num_out; k++){
+      const float* inPtr = (const float*)(in + k * decim + 2 * p);
+      acc0 = _mm_mul_ps(_mm_loadu_ps(inPtr), t0);
+      acc1 = _mm_mul_ps(_mm_loadu_ps(inPtr + 4), t1);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(inPtr + 8), t2));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(inPtr + 12), t3));
+      acc0 = _mm_add_ps(acc0, acc1);
+      acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+      _mm_store_ps(sum, acc0);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+
+  for(; p < pairs; p++){
+    t = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(taps + 2 * p));
+    t0 = _mm_unpacklo_ps(t, t);
+    for(k = 0; k < num_out; k++){
+      acc0 = _mm_mul_ps(_mm_loadu_ps((const float*)(in + k * decim + 2 * p)), t0);
+      acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+      _mm_store_ps(sum, acc0);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_u_avx(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                   unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  const unsigned int quads = ntaps / 4;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  unsigned int q = 0, k;
+  __m128 t, half;
+  __m256 t0, t1, t2, t3, acc0, acc1;
+
+  fir_decim_32fc_tail(out, in, taps, quads * 4, ntaps, decim, num_out);
+
+  //taps t0|t0|t1|t1|t2|t2|t3|t3 in the complex lanes, sixteen at a time,
+  //kept in registers for all outputs
+  for(; q + 4 <= quads; q += 4){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 4);
+    t1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 8);
+    t2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 12);
+    t3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      const float* inPtr = (const float*)(in + k * decim + 4 * q);
+      acc0 = _mm256_mul_ps(_mm256_loadu_ps(inPtr), t0);
+      acc1 = _mm256_mul_ps(_mm256_loadu_ps(inPtr + 8), t1);
+      acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(inPtr + 16), t2));
+      acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(inPtr + 24), t3));
+      acc0 = _mm256_add_ps(acc0, acc1);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+
+  for(; q < quads; q++){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      acc0 = _mm256_mul_ps(_mm256_loadu_ps((const float*)(in + k * decim + 4 * q)), t0);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_u_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                        unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  const unsigned int quads = ntaps / 4;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  unsigned int q = 0, k;
+  __m128 t, half;
+  __m256 t0, t1, t2, t3, acc0, acc1;
+
+  fir_decim_32fc_tail(out, in, taps, quads * 4, ntaps, decim, num_out);
+
+  //taps t0|t0|t1|t1|t2|t2|t3|t3 in the complex lanes, sixteen at a time,
+  //kept in registers for all outputs
+  for(; q + 4 <= quads; q += 4){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 4);
+    t1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 8);
+    t2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 12);
+    t3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      const float* inPtr = (const float*)(in + k * decim + 4 * q);
+      acc0 = _mm256_mul_ps(_mm256_loadu_ps(inPtr), t0);
+      acc1 = _mm256_mul_ps(_mm256_loadu_ps(inPtr + 8), t1);
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(inPtr + 16), t2, acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(inPtr + 24), t3, acc1);
+      acc0 = _mm256_add_ps(acc0, acc1);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+
+  for(; q < quads; q++){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      acc0 = _mm256_mul_ps(_mm256_loadu_ps((const float*)(in + k * decim + 4 * q)), t0);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_32f_fir_decim_32fc_u_H */
+
+
+#ifndef INCLUDED_volk_32fc_32f_fir_decim_32fc_a_H
+#define INCLUDED_volk_32fc_32f_fir_decim_32fc_a_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_a_sse(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                   unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  if(decim % 2 != 0){
+    //windows after the first are misaligned
+    volk_32fc_32f_fir_decim_32fc_u_sse(out, in, taps, ntaps, decim, num_out);
+    return;
+  }
+
+  const unsigned int pairs = ntaps / 2;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  unsigned int p = 0, k;
+  __m128 t, t0, t1, t2, t3, acc0, acc1;
+
+  fir_decim_32fc_tail(out, in, taps, pairs * 2, ntaps, decim, num_out);
+
+  //taps t0|t0|t1|t1 in the complex lanes, kept in registers for all outputs
+  for(; p + 4 <= pairs; p += 4){
+    t = _mm_loadu_ps(taps + 2 * p);
+    t0 = _mm_unpacklo_ps(t, t);
+    t1 = _mm_unpackhi_ps(t, t);
+    t = _mm_loadu_ps(taps + 2 * p + 4);
+    t2 = _mm_unpacklo_ps(t, t);
+    t3 = _mm_unpackhi_ps(t, t);
+    for(k = 0; k < num_out; k++){
+      const float* inPtr = (const float*)(in + k * decim + 2 * p);
+      acc0 = _mm_mul_ps(_mm_load_ps(inPtr), t0);
+      acc1 = _mm_mul_ps(_mm_load_ps(inPtr + 4), t1);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(inPtr + 8), t2));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load_ps(inPtr + 12), t3));
+      acc0 = _mm_add_ps(acc0, acc1);
+      acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+      _mm_store_ps(sum, acc0);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+
+  for(; p < pairs; p++){
+    t = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(taps + 2 * p));
+    t0 = _mm_unpacklo_ps(t, t);
+    for(k = 0; k < num_out; k++){
+      acc0 = _mm_mul_ps(_mm_load_ps((const float*)(in + k * decim + 2 * p)), t0);
+      acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+      _mm_store_ps(sum, acc0);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_a_avx(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                   unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  if(decim % 4 != 0){
+    //windows after the first are misaligned
+    volk_32fc_32f_fir_decim_32fc_u_avx(out, in, taps, ntaps, decim, num_out);
+    return;
+  }
+
+  const unsigned int quads = ntaps / 4;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  unsigned int q = 0, k;
+  __m128 t, half;
+  __m256 t0, t1, t2, t3, acc0, acc1;
+
+  fir_decim_32fc_tail(out, in, taps, quads * 4, ntaps, decim, num_out);
+
+  //taps t0|t0|t1|t1|t2|t2|t3|t3 in the complex lanes, sixteen at a time,
+  //kept in registers for all outputs
+  for(; q + 4 <= quads; q += 4){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 4);
+    t1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 8);
+    t2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 12);
+    t3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      const float* inPtr = (const float*)(in + k * decim + 4 * q);
+      acc0 = _mm256_mul_ps(_mm256_load_ps(inPtr), t0);
+      acc1 = _mm256_mul_ps(_mm256_load_ps(inPtr + 8), t1);
+      acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_load_ps(inPtr + 16), t2));
+      acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_load_ps(inPtr + 24), t3));
+      acc0 = _mm256_add_ps(acc0, acc1);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+
+  for(; q < quads; q++){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      acc0 = _mm256_mul_ps(_mm256_load_ps((const float*)(in + k * decim + 4 * q)), t0);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+
+static inline void
+volk_32fc_32f_fir_decim_32fc_a_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const float* taps,
+                                        unsigned int ntaps, unsigned int decim, unsigned int num_out)
+{
+  if(decim % 4 != 0){
+    //windows after the first are misaligned
+    volk_32fc_32f_fir_decim_32fc_u_avx2_fma(out, in, taps, ntaps, decim, num_out);
+    return;
+  }
+
+  const unsigned int quads = ntaps / 4;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  unsigned int q = 0, k;
+  __m128 t, half;
+  __m256 t0, t1, t2, t3, acc0, acc1;
+
+  fir_decim_32fc_tail(out, in, taps, quads * 4, ntaps, decim, num_out);
+
+  //taps t0|t0|t1|t1|t2|t2|t3|t3 in the complex lanes, sixteen at a time,
+  //kept in registers for all outputs
+  for(; q + 4 <= quads; q += 4){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 4);
+    t1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 8);
+    t2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    t = _mm_loadu_ps(taps + 4 * q + 12);
+    t3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      const float* inPtr = (const float*)(in + k * decim + 4 * q);
+      acc0 = _mm256_mul_ps(_mm256_load_ps(inPtr), t0);
+      acc1 = _mm256_mul_ps(_mm256_load_ps(inPtr + 8), t1);
+      acc0 = _mm256_fmadd_ps(_mm256_load_ps(inPtr + 16), t2, acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_load_ps(inPtr + 24), t3, acc1);
+      acc0 = _mm256_add_ps(acc0, acc1);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+
+  for(; q < quads; q++){
+    t = _mm_loadu_ps(taps + 4 * q);
+    t0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t, t)), _mm_unpackhi_ps(t, t), 1);
+    for(k = 0; k < num_out; k++){
+      acc0 = _mm256_mul_ps(_mm256_load_ps((const float*)(in + k * decim + 4 * q)), t0);
+      half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+      half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+      _mm_store_ps(sum, half);
+      out[k] += lv_cmake(sum[0], sum[1]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_32f_fir_decim_32fc_a_H */
@@ -0,0 +1,112 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This puppet is for VOLK tests only.
+ * For documentation see 'kernels/volk/volk_32fc_32f_fir_decim_32fc.h'
+ */
+
+#ifndef INCLUDED_volk_32fc_32f_fir_decimpuppet_32fc_H
+#define INCLUDED_volk_32fc_32f_fir_decimpuppet_32fc_H
+
+#include <volk/volk_32fc_32f_fir_decim_32fc.h>
+#include <string.h>
+
+//enough taps to reach every SIMD tile, leftover group and scalar tap;
+//decimating by a whole AVX vector also runs the aligned loads
+#define FIR_DECIM_PUPPET_NTAPS 23
+#define FIR_DECIM_PUPPET_DECIM 4
+
+static inline unsigned int
+fir_decim_puppet_num_out(lv_32fc_t* out, unsigned int num_points)
+{
+  unsigned int num_out = 0;
+  if(num_points >= FIR_DECIM_PUPPET_NTAPS)
+    num_out = (num_points - FIR_DECIM_PUPPET_NTAPS) / FIR_DECIM_PUPPET_DECIM + 1;
+  memset(out + num_out, 0, sizeof(lv_32fc_t) * (num_points - num_out));
+  return num_out;
+}
+
+#ifdef LV_HAVE_GENERIC
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_generic(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_u_sse(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_u_sse(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_SSE */
+
+#ifdef LV_HAVE_SSE
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_a_sse(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_a_sse(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_SSE */
+
+#ifdef LV_HAVE_AVX
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_u_avx(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_u_avx(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_AVX */
+
+#ifdef LV_HAVE_AVX
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_a_avx(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_a_avx(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_AVX */
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_u_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_u_avx2_fma(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+static inline void
+volk_32fc_32f_fir_decimpuppet_32fc_a_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const float* taps, unsigned int num_points)
+{
+  const unsigned int num_out = fir_decim_puppet_num_out(out, num_points);
+  volk_32fc_32f_fir_decim_32fc_a_avx2_fma(out, in, taps, FIR_DECIM_PUPPET_NTAPS, FIR_DECIM_PUPPET_DECIM, num_out);
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_32f_fir_decimpuppet_32fc_H */
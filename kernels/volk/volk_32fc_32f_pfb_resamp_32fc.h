@@ -0,0 +1,255 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*!
+ * \page volk_32fc_32f_pfb_resamp_32fc
+ *
+ * \b Overview
+ *
+ * Resamples complex samples by an arbitrary rate with a polyphase
+ * filterbank. Each output sits state->phase branches past input sample
+ * state->index: it is the dot product of the \p ntaps samples from there
+ * with the branch below that phase, linearly blended into the branch
+ * above it by the fractional part of the phase. After each output the
+ * phase advances by state->phase_inc, and every nfilts branches move
+ * the index on by one sample.
+ *
+ * The bank is branch-major: row b holds the \p ntaps taps of branch b
+ * contiguously at bank + b * ntaps, with taps in the order they meet
+ * the input. There are nfilts + 1 rows; the last one is row 0 delayed
+ * by one sample (row[nfilts][0] = 0, row[nfilts][t] = row[0][t - 1]),
+ * so that phases just short of nfilts blend towards the next sample.
+ *
+ * The caller owns \p state and passes it back on the next call. On
+ * return state->index is the first input sample the next output needs;
+ * drop that many samples from the input and zero the index, or keep the
+ * buffer and let the index grow.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_32fc_32f_pfb_resamp_32fc(lv_32fc_t* out, const lv_32fc_t* in, const float* bank, volk_resamp_state_t* state, unsigned int num_out)
+ * \endcode
+ *
+ * \b Inputs
+ * \li in: complex samples, up to the last output's index + ntaps
+ * \li bank: the (nfilts + 1) * ntaps branch-major filterbank
+ * \li state: phase, phase_inc, index, nfilts and ntaps; updated in place
+ * \li num_out: number of outputs to compute
+ *
+ * \b Outputs
+ * \li out: num_out resampled samples
+ *
+ * \b Example
+ * Resample by 1 / 1.37 with a 32 branch bank cut from a prototype low
+ * pass filter proto[] of 32 * ntaps taps designed at 32 times the input
+ * rate.
+ * \code
+ * volk_resamp_state_t state;
+ * unsigned int b, t;
+ * state.nfilts = 32;
+ * state.ntaps = ntaps;
+ * state.phase = 0.0f;
+ * state.phase_inc = 32 * 1.37f;
+ * state.index = 0;
+ *
+ * float* bank = (float*)volk_malloc(sizeof(float) * (state.nfilts + 1) * ntaps, volk_get_alignment());
+ * for(b = 0; b <= state.nfilts; b++){
+ *   for(t = 0; t < ntaps; t++){
+ *     unsigned int i = (ntaps - 1 - t) * state.nfilts + b;
+ *     bank[b * ntaps + t] = i < state.nfilts * ntaps ? proto[i] : 0.0f;
+ *   }
+ * }
+ *
+ * volk_32fc_32f_pfb_resamp_32fc(out, in, bank, &state, num_out);
+ * //in + state.index is where the next call starts
+ *
+ * volk_free(bank);
+ * \endcode
+ */
+
+#ifndef INCLUDED_volk_32fc_32f_pfb_resamp_32fc_u_H
+#define INCLUDED_volk_32fc_32f_pfb_resamp_32fc_u_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#include <volk/volk_resamp.h>
+
+//the taps from first on, blended between two adjacent branches
+static inline lv_32fc_t
+pfb_resamp_32fc_tail(const lv_32fc_t* in, const float* b0, const float* b1, float frac,
+                     unsigned int first, unsigned int ntaps)
+{
+  const float* inPtr = (const float*)in;
+  float re = 0.0f, im = 0.0f, tap;
+  unsigned int j;
+  for(j = first; j < ntaps; j++){
+    tap = b0[j] + frac * (b1[j] - b0[j]);
+    re += inPtr[2 * j] * tap;
+    im += inPtr[2 * j + 1] * tap;
+  }
+  return lv_cmake(re, im);
+}
+
+//moves the phase on by one output; every impl steps it the same way
+static inline void
+pfb_resamp_32fc_advance(float* phase, unsigned int* index, float phase_inc, unsigned int nfilts)
+{
+  unsigned int whole;
+  *phase += phase_inc;
+  if(*phase >= (float)nfilts){
+    whole = (unsigned int)(*phase / (float)nfilts);
+    *index += whole;
+    *phase -= (float)(whole * nfilts);
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_32fc_32f_pfb_resamp_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, const float* bank,
+                                      volk_resamp_state_t* state, unsigned int num_out)
+{
+  const unsigned int ntaps = state->ntaps;
+  float phase = state->phase;
+  unsigned int index = state->index;
+  unsigned int k, branch;
+
+  for(k = 0; k < num_out; k++){
+    branch = (unsigned int)phase;
+    out[k] = pfb_resamp_32fc_tail(in + index, bank + branch * ntaps, bank + (branch + 1) * ntaps,
+                                  phase - (float)branch, 0, ntaps);
+    pfb_resamp_32fc_advance(&phase, &index, state->phase_inc, state->nfilts);
+  }
+
+  state->phase = phase;
+  state->index = index;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+
+static inline void
+volk_32fc_32f_pfb_resamp_32fc_u_sse(lv_32fc_t* out, const lv_32fc_t* in, const float* bank,
+                                    volk_resamp_state_t* state, unsigned int num_out)
+{
+  const unsigned int ntaps = state->ntaps;
+  const unsigned int quads = ntaps / 4;
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  float phase = state->phase;
+  unsigned int index = state->index;
+  unsigned int k, q;
+  __m128 f, t, acc0, acc1;
+
+  for(k = 0; k < num_out; k++){
+    const unsigned int branch = (unsigned int)phase;
+    const float* b0 = bank + branch * ntaps;
+    const float* b1 = b0 + ntaps;
+    const float* inPtr = (const float*)(in + index);
+    f = _mm_set1_ps(phase - (float)branch);
+    acc0 = _mm_setzero_ps();
+    acc1 = _mm_setzero_ps();
+
+    //blend four taps, then spread them over the complex lanes t0|t0|t1|t1
+    for(q = 0; q < quads; q++){
+      t = _mm_loadu_ps(b0 + 4 * q);
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b1 + 4 * q), t), f));
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(inPtr + 8 * q), _mm_unpacklo_ps(t, t)));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(inPtr + 8 * q + 4), _mm_unpackhi_ps(t, t)));
+    }
+    acc0 = _mm_add_ps(acc0, acc1);
+    acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+    _mm_store_ps(sum, acc0);
+
+    out[k] = lv_cmake(sum[0], sum[1]) +
+             pfb_resamp_32fc_tail(in + index, b0, b1, phase - (float)branch, quads * 4, ntaps);
+    pfb_resamp_32fc_advance(&phase, &index, state->phase_inc, state->nfilts);
+  }
+
+  state->phase = phase;
+  state->index = index;
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+
+static inline void
+volk_32fc_32f_pfb_resamp_32fc_u_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const float* bank,
+                                         volk_resamp_state_t* state, unsigned int num_out)
+{
+  const unsigned int ntaps = state->ntaps;
+  const unsigned int octs = ntaps / 8;
+  const unsigned int quads = (ntaps % 8) / 4;
+  const __m256i lo_idx = _mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0);
+  const __m256i hi_idx = _mm256_set_epi32(7, 7, 6, 6, 5, 5, 4, 4);
+  __VOLK_ATTR_ALIGNED(16) float sum[4];
+  float phase = state->phase;
+  unsigned int index = state->index;
+  unsigned int k, o;
+  __m128 f4, t4, half;
+  __m256 f, t, acc0, acc1;
+
+  for(k = 0; k < num_out; k++){
+    const unsigned int branch = (unsigned int)phase;
+    const float* b0 = bank + branch * ntaps;
+    const float* b1 = b0 + ntaps;
+    const float* inPtr = (const float*)(in + index);
+    f = _mm256_set1_ps(phase - (float)branch);
+    acc0 = _mm256_setzero_ps();
+    acc1 = _mm256_setzero_ps();
+
+    //blend eight taps, then spread them over the complex lanes t0|t0|..|t3|t3
+    for(o = 0; o < octs; o++){
+      t = _mm256_loadu_ps(b0 + 8 * o);
+      t = _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(b1 + 8 * o), t), f, t);
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(inPtr + 16 * o), _mm256_permutevar8x32_ps(t, lo_idx), acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(inPtr + 16 * o + 8), _mm256_permutevar8x32_ps(t, hi_idx), acc1);
+    }
+    if(quads){
+      f4 = _mm256_castps256_ps128(f);
+      t4 = _mm_loadu_ps(b0 + 8 * octs);
+      t4 = _mm_fmadd_ps(_mm_sub_ps(_mm_loadu_ps(b1 + 8 * octs), t4), f4, t4);
+      t = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t4, t4)), _mm_unpackhi_ps(t4, t4), 1);
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(inPtr + 16 * octs), t, acc0);
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    _mm_store_ps(sum, half);
+
+    out[k] = lv_cmake(sum[0], sum[1]) +
+             pfb_resamp_32fc_tail(in + index, b0, b1, phase - (float)branch, 8 * octs + 4 * quads, ntaps);
+    pfb_resamp_32fc_advance(&phase, &index, state->phase_inc, state->nfilts);
+  }
+
+  state->phase = phase;
+  state->index = index;
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_32f_pfb_resamp_32fc_u_H */
@@ -0,0 +1,90 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This puppet is for VOLK tests only.
+ * For documentation see 'kernels/volk/volk_32fc_32f_pfb_resamp_32fc.h'
+ */
+
+#ifndef INCLUDED_volk_32fc_32f_pfb_resamppuppet_32fc_H
+#define INCLUDED_volk_32fc_32f_pfb_resamppuppet_32fc_H
+
+#include <volk/volk_32fc_32f_pfb_resamp_32fc.h>
+#include <string.h>
+
+//19 taps reach the vector loops and the scalar tail; the rate is not a
+//whole number of branches, so the blend between branches is exercised
+#define PFB_RESAMP_PUPPET_NFILTS 32
+#define PFB_RESAMP_PUPPET_NTAPS 19
+#define PFB_RESAMP_PUPPET_RATE 1.37
+
+//the first num_points floats of the random input double as the bank;
+//the outputs are split over two calls to carry the state between them
+static inline unsigned int
+pfb_resamp_puppet_setup(lv_32fc_t* out, volk_resamp_state_t* state, unsigned int num_points)
+{
+  unsigned int num_out = 0;
+  state->phase = 0.0f;
+  state->phase_inc = (float)(PFB_RESAMP_PUPPET_NFILTS * PFB_RESAMP_PUPPET_RATE);
+  state->index = 0;
+  state->nfilts = PFB_RESAMP_PUPPET_NFILTS;
+  state->ntaps = PFB_RESAMP_PUPPET_NTAPS;
+  if(num_points >= (PFB_RESAMP_PUPPET_NFILTS + 1) * PFB_RESAMP_PUPPET_NTAPS)
+    num_out = (unsigned int)((num_points - PFB_RESAMP_PUPPET_NTAPS - 2) / PFB_RESAMP_PUPPET_RATE);
+  memset(out + num_out, 0, sizeof(lv_32fc_t) * (num_points - num_out));
+  return num_out;
+}
+
+#ifdef LV_HAVE_GENERIC
+static inline void
+volk_32fc_32f_pfb_resamppuppet_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, const float* bank, unsigned int num_points)
+{
+  volk_resamp_state_t state;
+  const unsigned int num_out = pfb_resamp_puppet_setup(out, &state, num_points);
+  volk_32fc_32f_pfb_resamp_32fc_generic(out, in, bank, &state, num_out / 2);
+  volk_32fc_32f_pfb_resamp_32fc_generic(out + num_out / 2, in, bank, &state, num_out - num_out / 2);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE
+static inline void
+volk_32fc_32f_pfb_resamppuppet_32fc_u_sse(lv_32fc_t* out, const lv_32fc_t* in, const float* bank, unsigned int num_points)
+{
+  volk_resamp_state_t state;
+  const unsigned int num_out = pfb_resamp_puppet_setup(out, &state, num_points);
+  volk_32fc_32f_pfb_resamp_32fc_u_sse(out, in, bank, &state, num_out / 2);
+  volk_32fc_32f_pfb_resamp_32fc_u_sse(out + num_out / 2, in, bank, &state, num_out - num_out / 2);
+}
+#endif /* LV_HAVE_SSE */
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+static inline void
+volk_32fc_32f_pfb_resamppuppet_32fc_u_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const float* bank, unsigned int num_points)
+{
+  volk_resamp_state_t state;
+  const unsigned int num_out = pfb_resamp_puppet_setup(out, &state, num_points);
+  volk_32fc_32f_pfb_resamp_32fc_u_avx2_fma(out, in, bank, &state, num_out / 2);
+  volk_32fc_32f_pfb_resamp_32fc_u_avx2_fma(out + num_out / 2, in, bank, &state, num_out - num_out / 2);
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_32f_pfb_resamppuppet_32fc_H */
@@ -0,0 +1,142 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This puppet is for VOLK tests only.
+ * For documentation see 'kernels/volk/volk_32fc_x2_fft_radix4_32fc.h'
+ */
+
+#ifndef INCLUDED_volk_32fc_fft_radix4puppet_32fc_H
+#define INCLUDED_volk_32fc_fft_radix4puppet_32fc_H
+
+#include <volk/volk_32fc_x2_fft_radix4_32fc.h>
+#include <volk/volk_malloc.h>
+#include <string.h>
+
+//an odd power of two, so the transforms end with the radix-2 pass
+#define FFT_RADIX4_PUPPET_SIZE 2048
+
+typedef void (*fft_radix4puppet_pass_t)(lv_32fc_t*, const lv_32fc_t*, const lv_32fc_t*,
+                                        unsigned int, unsigned int);
+
+//the same table as fft_radix4_twiddles, but each run of twiddles is
+//stepped by a complex multiply in double instead of a cos and sin per
+//entry; the puppet rebuilds it on every call, so it has to be cheap next
+//to the passes
+static inline void
+fft_radix4puppet_twiddles(lv_32fc_t* twiddles, unsigned int num_points)
+{
+  unsigned int n, m, p, k;
+  double w, c, s, re, im, t;
+  for(n = num_points; n >= 4; n /= 4){
+    m = n / 4;
+    for(k = 1; k <= 3; k++){
+      w = -2.0 * M_PI * (double)k / (double)n;
+      c = cos(w);
+      s = sin(w);
+      re = 1.0;
+      im = 0.0;
+      for(p = 0; p < m; p++){
+        *twiddles++ = lv_cmake((float)re, (float)im);
+        t = re * c - im * s;
+        im = re * s + im * c;
+        re = t;
+      }
+    }
+  }
+}
+
+//transforms every whole block of the input and zeroes what is left over;
+//the twiddles and the work block live in the calling thread's scratch
+//arena, so nothing outlives the call; the output is all zeros when the
+//arena cannot grow
+static inline void
+fft_radix4puppet_run(fft_radix4puppet_pass_t pass, lv_32fc_t* out, const lv_32fc_t* in,
+                     unsigned int num_points)
+{
+  const unsigned int N = FFT_RADIX4_PUPPET_SIZE;
+  const unsigned int blocks = num_points / N;
+  const size_t mark = volk_scratch_mark();
+  lv_32fc_t* tw = (lv_32fc_t*)volk_scratch_get(sizeof(lv_32fc_t) * fft_radix4_twiddles_size(N), 64);
+  lv_32fc_t* work = (lv_32fc_t*)volk_scratch_get(sizeof(lv_32fc_t) * N, 64);
+  const lv_32fc_t *src, *t;
+  lv_32fc_t* dst;
+  unsigned int i, stride, passes = 0;
+
+  if(tw == NULL || work == NULL){
+    memset(out, 0, sizeof(lv_32fc_t) * num_points);
+    volk_scratch_release(mark);
+    return;
+  }
+  fft_radix4puppet_twiddles(tw, N);
+
+  for(stride = 1; stride < N; stride *= 4) passes++;
+
+  for(i = 0; i < blocks; i++){
+    //land the last pass in out
+    src = in + i * N;
+    dst = (passes % 2) ? out + i * N : work;
+    t = tw;
+    for(stride = 1; stride < N; stride *= 4){
+      pass(dst, src, t, stride, N);
+      t += 3 * (N / stride / 4);
+      src = dst;
+      dst = (dst == work) ? out + i * N : work;
+    }
+  }
+  memset(out + blocks * N, 0, sizeof(lv_32fc_t) * (num_points - blocks * N));
+  volk_scratch_release(mark);
+}
+
+#ifdef LV_HAVE_GENERIC
+static inline void
+volk_32fc_fft_radix4puppet_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points)
+{
+  fft_radix4puppet_run(volk_32fc_x2_fft_radix4_32fc_generic, out, in, num_points);
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE3
+static inline void
+volk_32fc_fft_radix4puppet_32fc_u_sse3(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points)
+{
+  fft_radix4puppet_run(volk_32fc_x2_fft_radix4_32fc_u_sse3, out, in, num_points);
+}
+#endif /* LV_HAVE_SSE3 */
+
+#ifdef LV_HAVE_AVX
+static inline void
+volk_32fc_fft_radix4puppet_32fc_u_avx(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points)
+{
+  fft_radix4puppet_run(volk_32fc_x2_fft_radix4_32fc_u_avx, out, in, num_points);
+}
+#endif /* LV_HAVE_AVX */
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+static inline void
+volk_32fc_fft_radix4puppet_32fc_u_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points)
+{
+  fft_radix4puppet_run(volk_32fc_x2_fft_radix4_32fc_u_avx2_fma, out, in, num_points);
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_fft_radix4puppet_32fc_H */
@@ -75,6 +75,44 @@
 #include <stdio.h>
 #include <math.h>
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void
+volk_32fc_magnitude_squared_32f_u_avx512f(float* magnitudeVector, const lv_32fc_t* complexVector,
+                                          unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int sixteenthPoints = num_points / 16;
+
+  const float* complexVectorPtr = (float*) complexVector;
+  float* magnitudeVectorPtr = magnitudeVector;
+
+  __m512 cplxValue1, cplxValue2, result;
+
+  for(; number < sixteenthPoints; number++){
+    cplxValue1 = _mm512_loadu_ps(complexVectorPtr);
+    cplxValue2 = _mm512_loadu_ps(complexVectorPtr + 16);
+    result = _mm512_magnitudesquared_ps(cplxValue1, cplxValue2);
+    _mm512_storeu_ps(magnitudeVectorPtr, result);
+
+    complexVectorPtr += 32;
+    magnitudeVectorPtr += 16;
+  }
+
+  // The remaining points span up to two registers of interleaved input
+  const unsigned int tailPoints = num_points % 16;
+  const __mmask16 loadMask1 = _mm512_tailmask_ps(tailPoints > 8 ? 16 : 2 * tailPoints);
+  const __mmask16 loadMask2 = _mm512_tailmask_ps(tailPoints > 8 ? 2 * (tailPoints - 8) : 0);
+  cplxValue1 = _mm512_maskz_loadu_ps(loadMask1, complexVectorPtr);
+  cplxValue2 = _mm512_maskz_loadu_ps(loadMask2, complexVectorPtr + 16);
+  result = _mm512_magnitudesquared_ps(cplxValue1, cplxValue2);
+  _mm512_mask_storeu_ps(magnitudeVectorPtr, _mm512_tailmask_ps(tailPoints), result);
+}
+#endif /* LV_HAVE_AVX512F */
+
+
 #ifdef LV_HAVE_AVX
 #include <immintrin.h>
 #include <volk/volk_avx_intrinsics.h>
@@ -213,6 +251,44 @@ volk_32fc_magnitude_squared_32f_generic(float* magnitudeVector, const lv_32fc_t*
 #include <stdio.h>
 #include <math.h>
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void
+volk_32fc_magnitude_squared_32f_a_avx512f(float* magnitudeVector, const lv_32fc_t* complexVector,
+                                          unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int sixteenthPoints = num_points / 16;
+
+  const float* complexVectorPtr = (float*) complexVector;
+  float* magnitudeVectorPtr = magnitudeVector;
+
+  __m512 cplxValue1, cplxValue2, result;
+
+  for(; number < sixteenthPoints; number++){
+    cplxValue1 = _mm512_load_ps(complexVectorPtr);
+    cplxValue2 = _mm512_load_ps(complexVectorPtr + 16);
+    result = _mm512_magnitudesquared_ps(cplxValue1, cplxValue2);
+    _mm512_store_ps(magnitudeVectorPtr, result);
+
+    complexVectorPtr += 32;
+    magnitudeVectorPtr += 16;
+  }
+
+  // The remaining points span up to two registers of interleaved input
+  const unsigned int tailPoints = num_points % 16;
+  const __mmask16 loadMask1 = _mm512_tailmask_ps(tailPoints > 8 ? 16 : 2 * tailPoints);
+  const __mmask16 loadMask2 = _mm512_tailmask_ps(tailPoints > 8 ? 2 * (tailPoints - 8) : 0);
+  cplxValue1 = _mm512_maskz_load_ps(loadMask1, complexVectorPtr);
+  cplxValue2 = _mm512_maskz_load_ps(loadMask2, complexVectorPtr + 16);
+  result = _mm512_magnitudesquared_ps(cplxValue1, cplxValue2);
+  _mm512_mask_store_ps(magnitudeVectorPtr, _mm512_tailmask_ps(tailPoints), result);
+}
+#endif /* LV_HAVE_AVX512F */
+
+
 #ifdef LV_HAVE_AVX
 #include <immintrin.h>
 #include <volk/volk_avx_intrinsics.h>
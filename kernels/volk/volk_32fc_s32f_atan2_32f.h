@@ -28,6 +28,8 @@
  * Computes the arctan for each value in a complex vector and applies
  * a normalization factor.
  *
+ * The AVX2+FMA versions are within 4 ulp before the normalization.
+ *
  * <b>Dispatcher Prototype</b>
  * \code
  * void volk_32fc_s32f_atan2_32f(float* outputVector, const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points)
@@ -190,6 +192,62 @@ static inline void volk_32fc_s32f_atan2_32f_a_sse(float* outputVector,  const lv
 }
 #endif /* LV_HAVE_SSE */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void volk_32fc_s32f_atan2_32f_a_avx2_fma(float* outputVector,  const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points){
+  const float* complexVectorPtr = (float*)complexVector;
+  float* outPtr = outputVector;
+
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+  const float invNormalizeFactor = 1.0 / normalizeFactor;
+  const __m256 vNormalizeFactor = _mm256_set1_ps(invNormalizeFactor);
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  const __m256 pi = _mm256_set1_ps(3.14159265358979323846);
+  const __m256 pio2 = _mm256_set1_ps(3.14159265358979323846/2);
+  __m256 complex1, complex2, iValue, qValue, iAbs, qAbs, swap, num, den, phase;
+
+  for (; number < eighthPoints; number++) {
+    complex1 = _mm256_load_ps(complexVectorPtr);
+    complexVectorPtr += 8;
+    complex2 = _mm256_load_ps(complexVectorPtr);
+    complexVectorPtr += 8;
+    // Deinterleave IQ data, leaving points 0 1 4 5 2 3 6 7 in the lanes
+    iValue = _mm256_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm256_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+
+    // atan of the smaller over the larger magnitude lies in [0, pi/4]
+    iAbs = _mm256_andnot_ps(sign_mask, iValue);
+    qAbs = _mm256_andnot_ps(sign_mask, qValue);
+    swap = _mm256_cmp_ps(qAbs, iAbs, _CMP_GT_OQ);
+    num = _mm256_min_ps(iAbs, qAbs);
+    den = _mm256_max_ps(iAbs, qAbs);
+    // atan2(0, 0) is 0 rather than 0/0
+    phase = _mm256_and_ps(_mm256_div_ps(num, den), _mm256_cmp_ps(den, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+    phase = _mm256_arctan_fma_ps(phase);
+
+    // unfold into the right octant: above the diagonal, left half plane, lower half plane
+    phase = _mm256_blendv_ps(phase, _mm256_sub_ps(pio2, phase), swap);
+    phase = _mm256_blendv_ps(phase, _mm256_sub_ps(pi, phase), iValue);
+    phase = _mm256_or_ps(phase, _mm256_and_ps(qValue, sign_mask));
+
+    phase = _mm256_mul_ps(phase, vNormalizeFactor);
+    phase = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(phase), _MM_SHUFFLE(3,1,2,0)));
+    _mm256_store_ps(outPtr, phase);
+    outPtr += 8;
+  }
+  number = eighthPoints * 8;
+
+  for (; number < num_points; number++) {
+    const float real = *complexVectorPtr++;
+    const float imag = *complexVectorPtr++;
+    *outPtr++ = atan2f(imag, real) * invNormalizeFactor;
+  }
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
 #ifdef LV_HAVE_GENERIC
 
 static inline void volk_32fc_s32f_atan2_32f_generic(float* outputVector, const lv_32fc_t* inputVector, const float normalizeFactor, unsigned int num_points){
@@ -209,3 +267,66 @@ static inline void volk_32fc_s32f_atan2_32f_generic(float* outputVector, const l
 
 
 #endif /* INCLUDED_volk_32fc_s32f_atan2_32f_a_H */
+
+#ifndef INCLUDED_volk_32fc_s32f_atan2_32f_u_H
+#define INCLUDED_volk_32fc_s32f_atan2_32f_u_H
+
+#include <math.h>
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void volk_32fc_s32f_atan2_32f_u_avx2_fma(float* outputVector,  const lv_32fc_t* complexVector, const float normalizeFactor, unsigned int num_points){
+  const float* complexVectorPtr = (float*)complexVector;
+  float* outPtr = outputVector;
+
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+  const float invNormalizeFactor = 1.0 / normalizeFactor;
+  const __m256 vNormalizeFactor = _mm256_set1_ps(invNormalizeFactor);
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  const __m256 pi = _mm256_set1_ps(3.14159265358979323846);
+  const __m256 pio2 = _mm256_set1_ps(3.14159265358979323846/2);
+  __m256 complex1, complex2, iValue, qValue, iAbs, qAbs, swap, num, den, phase;
+
+  for (; number < eighthPoints; number++) {
+    complex1 = _mm256_loadu_ps(complexVectorPtr);
+    complexVectorPtr += 8;
+    complex2 = _mm256_loadu_ps(complexVectorPtr);
+    complexVectorPtr += 8;
+    // Deinterleave IQ data, leaving points 0 1 4 5 2 3 6 7 in the lanes
+    iValue = _mm256_shuffle_ps(complex1, complex2, _MM_SHUFFLE(2,0,2,0));
+    qValue = _mm256_shuffle_ps(complex1, complex2, _MM_SHUFFLE(3,1,3,1));
+
+    // atan of the smaller over the larger magnitude lies in [0, pi/4]
+    iAbs = _mm256_andnot_ps(sign_mask, iValue);
+    qAbs = _mm256_andnot_ps(sign_mask, qValue);
+    swap = _mm256_cmp_ps(qAbs, iAbs, _CMP_GT_OQ);
+    num = _mm256_min_ps(iAbs, qAbs);
+    den = _mm256_max_ps(iAbs, qAbs);
+    // atan2(0, 0) is 0 rather than 0/0
+    phase = _mm256_and_ps(_mm256_div_ps(num, den), _mm256_cmp_ps(den, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+    phase = _mm256_arctan_fma_ps(phase);
+
+    // unfold into the right octant: above the diagonal, left half plane, lower half plane
+    phase = _mm256_blendv_ps(phase, _mm256_sub_ps(pio2, phase), swap);
+    phase = _mm256_blendv_ps(phase, _mm256_sub_ps(pi, phase), iValue);
+    phase = _mm256_or_ps(phase, _mm256_and_ps(qValue, sign_mask));
+
+    phase = _mm256_mul_ps(phase, vNormalizeFactor);
+    phase = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(phase), _MM_SHUFFLE(3,1,2,0)));
+    _mm256_storeu_ps(outPtr, phase);
+    outPtr += 8;
+  }
+  number = eighthPoints * 8;
+
+  for (; number < num_points; number++) {
+    const float real = *complexVectorPtr++;
+    const float imag = *complexVectorPtr++;
+    *outPtr++ = atan2f(imag, real) * invNormalizeFactor;
+  }
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
+#endif /* INCLUDED_volk_32fc_s32f_atan2_32f_u_H */
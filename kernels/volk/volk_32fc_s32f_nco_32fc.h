@@ -0,0 +1,318 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*!
+ * \page volk_32fc_s32f_nco_32fc
+ *
+ * \b Overview
+ *
+ * Mixes the input with a numerically controlled oscillator:
+ * outVector[n] = inVector[n] * exp(j * (phase + n * phase_inc)).
+ *
+ * Unlike volk_32fc_s32fc_x2_rotator_32fc, which multiplies a complex
+ * phasor up sample after sample and has to renormalize it, the phase
+ * here is accumulated in double precision and wrapped into [-pi, pi),
+ * so neither its amplitude nor its frequency drifts over long runs.
+ * Each phasor is then evaluated directly with the shared sine and
+ * cosine range reduction of volk_32f_expj_32fc.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_32fc_s32f_nco_32fc(lv_32fc_t* outVector, const lv_32fc_t* inVector, const float phase_inc, double* phase, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector: Vector to be mixed.
+ * \li phase_inc: The oscillator frequency in radians per sample.
+ * \li phase: The phase of the first sample in radians. On return it
+ *     holds the phase of the next sample, wrapped into [-pi, pi).
+ * \li num_points: The number of values in inVector.
+ *
+ * \b Outputs
+ * \li outVector: The mixed vector.
+ *
+ * \b Example
+ * Shift a DC input to f=0.1 rad/sample, keeping the phase across calls.
+ * \code
+ *   int N = 10;
+ *   unsigned int alignment = volk_get_alignment();
+ *   lv_32fc_t* in  = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t)*N, alignment);
+ *   lv_32fc_t* out = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t)*N, alignment);
+ *
+ *   for(unsigned int ii = 0; ii < N; ++ii){
+ *       in[ii] = lv_cmake(1.f, 0.f);
+ *   }
+ *   double phase = 0.0;
+ *
+ *   volk_32fc_s32f_nco_32fc(out, in, 0.1f, &phase, N);
+ *
+ *   for(unsigned int ii = 0; ii < N; ++ii){
+ *       printf("out[%u] = %+1.2f %+1.2fj\n",
+ *           ii, lv_creal(out[ii]), lv_cimag(out[ii]));
+ *   }
+ *
+ *   volk_free(in);
+ *   volk_free(out);
+ * \endcode
+ */
+
+#ifndef INCLUDED_volk_32fc_s32f_nco_32fc_a_H
+#define INCLUDED_volk_32fc_s32f_nco_32fc_a_H
+
+#include <math.h>
+#include <volk/volk_complex.h>
+
+// brings a phase into [-pi, pi)
+static inline double
+nco_32fc_wrap(double phase)
+{
+  const double two_pi = 6.283185307179586476925286766559;
+  return phase - two_pi * floor(phase / two_pi + 0.5);
+}
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+#include <volk/volk_sse3_intrinsics.h>
+#include <volk/volk_sse41_intrinsics.h>
+
+static inline void
+volk_32fc_s32f_nco_32fc_a_sse4_1(lv_32fc_t* outVector, const lv_32fc_t* inVector,
+                                 const float phase_inc, double* phase, unsigned int num_points)
+{
+  const __m128d two_pi = _mm_set1_pd(6.283185307179586476925286766559);
+  const __m128d inv_two_pi = _mm_set1_pd(0.15915494309189533576888376337251);
+  const __m128d offset01 = _mm_setr_pd(0.0, phase_inc);
+  const __m128d offset23 = _mm_setr_pd(2.0 * phase_inc, 3.0 * phase_inc);
+  const double block_inc = 4.0 * phase_inc;
+  const float* inPtr = (const float*)inVector;
+  float* outPtr = (float*)outVector;
+  const unsigned int quarterPoints = num_points / 4;
+  unsigned int number = 0;
+  double p = nco_32fc_wrap(*phase);
+  __m128d p01, p23;
+  __m128 s, c;
+
+  for(; number < quarterPoints; number++){
+    p01 = _mm_add_pd(_mm_set1_pd(p), offset01);
+    p23 = _mm_add_pd(_mm_set1_pd(p), offset23);
+    p01 = _mm_sub_pd(p01, _mm_mul_pd(two_pi, _mm_round_pd(_mm_mul_pd(p01, inv_two_pi),
+                                                          _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    p23 = _mm_sub_pd(p23, _mm_mul_pd(two_pi, _mm_round_pd(_mm_mul_pd(p23, inv_two_pi),
+                                                          _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    _mm_sincos_ps(_mm_movelh_ps(_mm_cvtpd_ps(p01), _mm_cvtpd_ps(p23)), &s, &c);
+
+    _mm_store_ps(outPtr, _mm_complexmul_ps(_mm_load_ps(inPtr), _mm_unpacklo_ps(c, s)));
+    _mm_store_ps(outPtr + 4, _mm_complexmul_ps(_mm_load_ps(inPtr + 4), _mm_unpackhi_ps(c, s)));
+    inPtr += 8;
+    outPtr += 8;
+    p = nco_32fc_wrap(p + block_inc);
+  }
+
+  for(number = quarterPoints * 4; number < num_points; number++){
+    outVector[number] = inVector[number] * lv_cmake(cosf((float)p), sinf((float)p));
+    p = nco_32fc_wrap(p + phase_inc);
+  }
+  *phase = p;
+}
+
+#endif /* LV_HAVE_SSE4_1 for aligned */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32fc_s32f_nco_32fc_a_avx2_fma(lv_32fc_t* outVector, const lv_32fc_t* inVector,
+                                   const float phase_inc, double* phase, unsigned int num_points)
+{
+  const __m256d two_pi = _mm256_set1_pd(6.283185307179586476925286766559);
+  const __m256d inv_two_pi = _mm256_set1_pd(0.15915494309189533576888376337251);
+  const __m256d offset0 = _mm256_setr_pd(0.0, phase_inc, 2.0 * phase_inc, 3.0 * phase_inc);
+  const __m256d offset1 = _mm256_setr_pd(4.0 * phase_inc, 5.0 * phase_inc,
+                                         6.0 * phase_inc, 7.0 * phase_inc);
+  const double block_inc = 8.0 * phase_inc;
+  const float* inPtr = (const float*)inVector;
+  float* outPtr = (float*)outVector;
+  const unsigned int eighthPoints = num_points / 8;
+  unsigned int number = 0;
+  double p = nco_32fc_wrap(*phase);
+  __m256d p0, p1;
+  __m256 s, c, lo, hi;
+
+  for(; number < eighthPoints; number++){
+    p0 = _mm256_add_pd(_mm256_set1_pd(p), offset0);
+    p1 = _mm256_add_pd(_mm256_set1_pd(p), offset1);
+    p0 = _mm256_fnmadd_pd(two_pi, _mm256_round_pd(_mm256_mul_pd(p0, inv_two_pi),
+                                                  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), p0);
+    p1 = _mm256_fnmadd_pd(two_pi, _mm256_round_pd(_mm256_mul_pd(p1, inv_two_pi),
+                                                  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), p1);
+    _mm256_sincos_fma_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(p0)),
+                                              _mm256_cvtpd_ps(p1), 1), &s, &c);
+
+    lo = _mm256_unpacklo_ps(c, s);
+    hi = _mm256_unpackhi_ps(c, s);
+    _mm256_store_ps(outPtr, _mm256_complexmul_fma_ps(_mm256_load_ps(inPtr),
+                                                     _mm256_permute2f128_ps(lo, hi, 0x20)));
+    _mm256_store_ps(outPtr + 8, _mm256_complexmul_fma_ps(_mm256_load_ps(inPtr + 8),
+                                                         _mm256_permute2f128_ps(lo, hi, 0x31)));
+    inPtr += 16;
+    outPtr += 16;
+    p = nco_32fc_wrap(p + block_inc);
+  }
+
+  for(number = eighthPoints * 8; number < num_points; number++){
+    outVector[number] = inVector[number] * lv_cmake(cosf((float)p), sinf((float)p));
+    p = nco_32fc_wrap(p + phase_inc);
+  }
+  *phase = p;
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for aligned */
+
+#endif /* INCLUDED_volk_32fc_s32f_nco_32fc_a_H */
+
+
+#ifndef INCLUDED_volk_32fc_s32f_nco_32fc_u_H
+#define INCLUDED_volk_32fc_s32f_nco_32fc_u_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_32fc_s32f_nco_32fc_generic(lv_32fc_t* outVector, const lv_32fc_t* inVector,
+                                const float phase_inc, double* phase, unsigned int num_points)
+{
+  double p = nco_32fc_wrap(*phase);
+  unsigned int number;
+
+  for(number = 0; number < num_points; number++){
+    outVector[number] = inVector[number] * lv_cmake(cosf((float)p), sinf((float)p));
+    p = nco_32fc_wrap(p + phase_inc);
+  }
+  *phase = p;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+#include <volk/volk_sse3_intrinsics.h>
+#include <volk/volk_sse41_intrinsics.h>
+
+static inline void
+volk_32fc_s32f_nco_32fc_u_sse4_1(lv_32fc_t* outVector, const lv_32fc_t* inVector,
+                                 const float phase_inc, double* phase, unsigned int num_points)
+{
+  const __m128d two_pi = _mm_set1_pd(6.283185307179586476925286766559);
+  const __m128d inv_two_pi = _mm_set1_pd(0.15915494309189533576888376337251);
+  const __m128d offset01 = _mm_setr_pd(0.0, phase_inc);
+  const __m128d offset23 = _mm_setr_pd(2.0 * phase_inc, 3.0 * phase_inc);
+  const double block_inc = 4.0 * phase_inc;
+  const float* inPtr = (const float*)inVector;
+  float* outPtr = (float*)outVector;
+  const unsigned int quarterPoints = num_points / 4;
+  unsigned int number = 0;
+  double p = nco_32fc_wrap(*phase);
+  __m128d p01, p23;
+  __m128 s, c;
+
+  for(; number < quarterPoints; number++){
+    p01 = _mm_add_pd(_mm_set1_pd(p), offset01);
+    p23 = _mm_add_pd(_mm_set1_pd(p), offset23);
+    p01 = _mm_sub_pd(p01, _mm_mul_pd(two_pi, _mm_round_pd(_mm_mul_pd(p01, inv_two_pi),
+                                                          _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    p23 = _mm_sub_pd(p23, _mm_mul_pd(two_pi, _mm_round_pd(_mm_mul_pd(p23, inv_two_pi),
+                                                          _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    _mm_sincos_ps(_mm_movelh_ps(_mm_cvtpd_ps(p01), _mm_cvtpd_ps(p23)), &s, &c);
+
+    _mm_storeu_ps(outPtr, _mm_complexmul_ps(_mm_loadu_ps(inPtr), _mm_unpacklo_ps(c, s)));
+    _mm_storeu_ps(outPtr + 4, _mm_complexmul_ps(_mm_loadu_ps(inPtr + 4), _mm_unpackhi_ps(c, s)));
+    inPtr += 8;
+    outPtr += 8;
+    p = nco_32fc_wrap(p + block_inc);
+  }
+
+  for(number = quarterPoints * 4; number < num_points; number++){
+    outVector[number] = inVector[number] * lv_cmake(cosf((float)p), sinf((float)p));
+    p = nco_32fc_wrap(p + phase_inc);
+  }
+  *phase = p;
+}
+
+#endif /* LV_HAVE_SSE4_1 for unaligned */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32fc_s32f_nco_32fc_u_avx2_fma(lv_32fc_t* outVector, const lv_32fc_t* inVector,
+                                   const float phase_inc, double* phase, unsigned int num_points)
+{
+  const __m256d two_pi = _mm256_set1_pd(6.283185307179586476925286766559);
+  const __m256d inv_two_pi = _mm256_set1_pd(0.15915494309189533576888376337251);
+  const __m256d offset0 = _mm256_setr_pd(0.0, phase_inc, 2.0 * phase_inc, 3.0 * phase_inc);
+  const __m256d offset1 = _mm256_setr_pd(4.0 * phase_inc, 5.0 * phase_inc,
+                                         6.0 * phase_inc, 7.0 * phase_inc);
+  const double block_inc = 8.0 * phase_inc;
+  const float* inPtr = (const float*)inVector;
+  float* outPtr = (float*)outVector;
+  const unsigned int eighthPoints = num_points / 8;
+  unsigned int number = 0;
+  double p = nco_32fc_wrap(*phase);
+  __m256d p0, p1;
+  __m256 s, c, lo, hi;
+
+  for(; number < eighthPoints; number++){
+    p0 = _mm256_add_pd(_mm256_set1_pd(p), offset0);
+    p1 = _mm256_add_pd(_mm256_set1_pd(p), offset1);
+    p0 = _mm256_fnmadd_pd(two_pi, _mm256_round_pd(_mm256_mul_pd(p0, inv_two_pi),
+                                                  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), p0);
+    p1 = _mm256_fnmadd_pd(two_pi, _mm256_round_pd(_mm256_mul_pd(p1, inv_two_pi),
+                                                  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), p1);
+    _mm256_sincos_fma_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(p0)),
+                                              _mm256_cvtpd_ps(p1), 1), &s, &c);
+
+    lo = _mm256_unpacklo_ps(c, s);
+    hi = _mm256_unpackhi_ps(c, s);
+    _mm256_storeu_ps(outPtr, _mm256_complexmul_fma_ps(_mm256_loadu_ps(inPtr),
+                                                      _mm256_permute2f128_ps(lo, hi, 0x20)));
+    _mm256_storeu_ps(outPtr + 8, _mm256_complexmul_fma_ps(_mm256_loadu_ps(inPtr + 8),
+                                                          _mm256_permute2f128_ps(lo, hi, 0x31)));
+    inPtr += 16;
+    outPtr += 16;
+    p = nco_32fc_wrap(p + block_inc);
+  }
+
+  for(number = eighthPoints * 8; number < num_points; number++){
+    outVector[number] = inVector[number] * lv_cmake(cosf((float)p), sinf((float)p));
+    p = nco_32fc_wrap(p + phase_inc);
+  }
+  *phase = p;
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA for unaligned */
+
+#endif /* INCLUDED_volk_32fc_s32f_nco_32fc_u_H */
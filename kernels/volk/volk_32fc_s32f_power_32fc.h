@@ -55,6 +55,8 @@
 #ifndef INCLUDED_volk_32fc_s32f_power_32fc_a_H
 #define INCLUDED_volk_32fc_s32f_power_32fc_a_H
 
+#define volk_32fc_s32f_power_32fc_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 #include <math.h>
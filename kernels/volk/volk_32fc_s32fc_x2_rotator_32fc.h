@@ -536,4 +536,282 @@ static inline void volk_32fc_s32fc_x2_rotator_32fc_u_avx(lv_32fc_t* outVector, c
 
 #endif /* LV_HAVE_AVX */
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx_intrinsics.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void volk_32fc_s32fc_x2_rotator_32fc_a_avx2_fma(lv_32fc_t* outVector, const lv_32fc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+    lv_32fc_t* cPtr = outVector;
+    const lv_32fc_t* aPtr = inVector;
+    lv_32fc_t incr = 1;
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t phase_Ptr[4] = {(*phase), (*phase), (*phase), (*phase)};
+
+    unsigned int i, j = 0;
+
+    for(i = 0; i < 4; ++i) {
+        phase_Ptr[i] *= incr;
+        incr *= (phase_inc);
+    }
+
+    __m256 aVal, phase_Val, inc_Val, z;
+
+    phase_Val = _mm256_load_ps((float*)phase_Ptr);
+    inc_Val = _mm256_set_ps(lv_cimag(incr), lv_creal(incr),lv_cimag(incr), lv_creal(incr),lv_cimag(incr), lv_creal(incr),lv_cimag(incr), lv_creal(incr));
+    const unsigned int fourthPoints = num_points / 4;
+
+    for(i = 0; i < (unsigned int)(fourthPoints/ROTATOR_RELOAD); i++) {
+        for(j = 0; j < ROTATOR_RELOAD; ++j) {
+
+            aVal = _mm256_load_ps((float*)aPtr);
+
+            z = _mm256_complexmul_fma_ps(aVal, phase_Val);
+            phase_Val = _mm256_complexmul_fma_ps(phase_Val, inc_Val);
+
+            _mm256_store_ps((float*)cPtr, z);
+
+            aPtr += 4;
+            cPtr += 4;
+        }
+        phase_Val = _mm256_complexnormalize_ps(phase_Val);
+    }
+    for(i = 0; i < fourthPoints%ROTATOR_RELOAD; ++i) {
+        aVal = _mm256_load_ps((float*)aPtr);
+
+        z = _mm256_complexmul_fma_ps(aVal, phase_Val);
+        phase_Val = _mm256_complexmul_fma_ps(phase_Val, inc_Val);
+
+        _mm256_store_ps((float*)cPtr, z);
+
+        aPtr += 4;
+        cPtr += 4;
+    }
+    if (i) {
+        phase_Val = _mm256_complexnormalize_ps(phase_Val);
+    }
+
+    _mm256_store_ps((float*)phase_Ptr, phase_Val);
+    for(i = 0; i < num_points%4; ++i) {
+        *cPtr++ = *aPtr++ * phase_Ptr[0];
+        phase_Ptr[0] *= (phase_inc);
+    }
+
+    (*phase) = phase_Ptr[0];
+
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx_intrinsics.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void volk_32fc_s32fc_x2_rotator_32fc_u_avx2_fma(lv_32fc_t* outVector, const lv_32fc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+    lv_32fc_t* cPtr = outVector;
+    const lv_32fc_t* aPtr = inVector;
+    lv_32fc_t incr = 1;
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t phase_Ptr[4] = {(*phase), (*phase), (*phase), (*phase)};
+
+    unsigned int i, j = 0;
+
+    for(i = 0; i < 4; ++i) {
+        phase_Ptr[i] *= incr;
+        incr *= (phase_inc);
+    }
+
+    __m256 aVal, phase_Val, inc_Val, z;
+
+    phase_Val = _mm256_load_ps((float*)phase_Ptr);
+    inc_Val = _mm256_set_ps(lv_cimag(incr), lv_creal(incr),lv_cimag(incr), lv_creal(incr),lv_cimag(incr), lv_creal(incr),lv_cimag(incr), lv_creal(incr));
+    const unsigned int fourthPoints = num_points / 4;
+
+    for(i = 0; i < (unsigned int)(fourthPoints/ROTATOR_RELOAD); i++) {
+        for(j = 0; j < ROTATOR_RELOAD; ++j) {
+
+            aVal = _mm256_loadu_ps((float*)aPtr);
+
+            z = _mm256_complexmul_fma_ps(aVal, phase_Val);
+            phase_Val = _mm256_complexmul_fma_ps(phase_Val, inc_Val);
+
+            _mm256_storeu_ps((float*)cPtr, z);
+
+            aPtr += 4;
+            cPtr += 4;
+        }
+        phase_Val = _mm256_complexnormalize_ps(phase_Val);
+    }
+    for(i = 0; i < fourthPoints%ROTATOR_RELOAD; ++i) {
+        aVal = _mm256_loadu_ps((float*)aPtr);
+
+        z = _mm256_complexmul_fma_ps(aVal, phase_Val);
+        phase_Val = _mm256_complexmul_fma_ps(phase_Val, inc_Val);
+
+        _mm256_storeu_ps((float*)cPtr, z);
+
+        aPtr += 4;
+        cPtr += 4;
+    }
+    if (i) {
+        phase_Val = _mm256_complexnormalize_ps(phase_Val);
+    }
+
+    _mm256_store_ps((float*)phase_Ptr, phase_Val);
+    for(i = 0; i < num_points%4; ++i) {
+        *cPtr++ = *aPtr++ * phase_Ptr[0];
+        phase_Ptr[0] *= (phase_inc);
+    }
+
+    (*phase) = phase_Ptr[0];
+
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void volk_32fc_s32fc_x2_rotator_32fc_a_avx512f(lv_32fc_t* outVector, const lv_32fc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+    lv_32fc_t* cPtr = outVector;
+    const lv_32fc_t* aPtr = inVector;
+    lv_32fc_t incr = 1;
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t phase_Ptr[8];
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t incr_Ptr[8];
+
+    unsigned int i, j = 0;
+
+    for(i = 0; i < 8; ++i) {
+        phase_Ptr[i] = (*phase) * incr;
+        incr *= (phase_inc);
+    }
+    for(i = 0; i < 8; ++i) {
+        incr_Ptr[i] = incr;
+    }
+
+    __m512 aVal, phase_Val, inc_Val, z;
+
+    phase_Val = _mm512_load_ps((float*)phase_Ptr);
+    inc_Val = _mm512_load_ps((float*)incr_Ptr);
+    const unsigned int eighthPoints = num_points / 8;
+
+    for(i = 0; i < (unsigned int)(eighthPoints/ROTATOR_RELOAD); i++) {
+        for(j = 0; j < ROTATOR_RELOAD; ++j) {
+
+            aVal = _mm512_load_ps((float*)aPtr);
+
+            z = _mm512_complexmul_ps(aVal, phase_Val);
+            phase_Val = _mm512_complexmul_ps(phase_Val, inc_Val);
+
+            _mm512_store_ps((float*)cPtr, z);
+
+            aPtr += 8;
+            cPtr += 8;
+        }
+        phase_Val = _mm512_complexnormalize_ps(phase_Val);
+    }
+    for(i = 0; i < eighthPoints%ROTATOR_RELOAD; ++i) {
+        aVal = _mm512_load_ps((float*)aPtr);
+
+        z = _mm512_complexmul_ps(aVal, phase_Val);
+        phase_Val = _mm512_complexmul_ps(phase_Val, inc_Val);
+
+        _mm512_store_ps((float*)cPtr, z);
+
+        aPtr += 8;
+        cPtr += 8;
+    }
+    if (i) {
+        phase_Val = _mm512_complexnormalize_ps(phase_Val);
+    }
+
+    // The register already holds the phases for the remaining points, so
+    // rotate them under a mask and resume from the first unused lane.
+    const unsigned int tailPoints = num_points % 8;
+    const __mmask16 tailMask = _mm512_tailmask_ps(2 * tailPoints);
+    aVal = _mm512_maskz_load_ps(tailMask, (float*)aPtr);
+    z = _mm512_complexmul_ps(aVal, phase_Val);
+    _mm512_mask_store_ps((float*)cPtr, tailMask, z);
+
+    _mm512_store_ps((float*)phase_Ptr, phase_Val);
+    (*phase) = phase_Ptr[tailPoints];
+
+}
+
+#endif /* LV_HAVE_AVX512F for aligned */
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void volk_32fc_s32fc_x2_rotator_32fc_u_avx512f(lv_32fc_t* outVector, const lv_32fc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+    lv_32fc_t* cPtr = outVector;
+    const lv_32fc_t* aPtr = inVector;
+    lv_32fc_t incr = 1;
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t phase_Ptr[8];
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t incr_Ptr[8];
+
+    unsigned int i, j = 0;
+
+    for(i = 0; i < 8; ++i) {
+        phase_Ptr[i] = (*phase) * incr;
+        incr *= (phase_inc);
+    }
+    for(i = 0; i < 8; ++i) {
+        incr_Ptr[i] = incr;
+    }
+
+    __m512 aVal, phase_Val, inc_Val, z;
+
+    phase_Val = _mm512_load_ps((float*)phase_Ptr);
+    inc_Val = _mm512_load_ps((float*)incr_Ptr);
+    const unsigned int eighthPoints = num_points / 8;
+
+    for(i = 0; i < (unsigned int)(eighthPoints/ROTATOR_RELOAD); i++) {
+        for(j = 0; j < ROTATOR_RELOAD; ++j) {
+
+            aVal = _mm512_loadu_ps((float*)aPtr);
+
+            z = _mm512_complexmul_ps(aVal, phase_Val);
+            phase_Val = _mm512_complexmul_ps(phase_Val, inc_Val);
+
+            _mm512_storeu_ps((float*)cPtr, z);
+
+            aPtr += 8;
+            cPtr += 8;
+        }
+        phase_Val = _mm512_complexnormalize_ps(phase_Val);
+    }
+    for(i = 0; i < eighthPoints%ROTATOR_RELOAD; ++i) {
+        aVal = _mm512_loadu_ps((float*)aPtr);
+
+        z = _mm512_complexmul_ps(aVal, phase_Val);
+        phase_Val = _mm512_complexmul_ps(phase_Val, inc_Val);
+
+        _mm512_storeu_ps((float*)cPtr, z);
+
+        aPtr += 8;
+        cPtr += 8;
+    }
+    if (i) {
+        phase_Val = _mm512_complexnormalize_ps(phase_Val);
+    }
+
+    // The register already holds the phases for the remaining points, so
+    // rotate them under a mask and resume from the first unused lane.
+    const unsigned int tailPoints = num_points % 8;
+    const __mmask16 tailMask = _mm512_tailmask_ps(2 * tailPoints);
+    aVal = _mm512_maskz_loadu_ps(tailMask, (float*)aPtr);
+    z = _mm512_complexmul_ps(aVal, phase_Val);
+    _mm512_mask_storeu_ps((float*)cPtr, tailMask, z);
+
+    _mm512_store_ps((float*)phase_Ptr, phase_Val);
+    (*phase) = phase_Ptr[tailPoints];
+
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
 #endif /* INCLUDED_volk_32fc_s32fc_rotator_32fc_a_H */
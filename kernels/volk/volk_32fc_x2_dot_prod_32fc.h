@@ -431,6 +431,105 @@ static inline void volk_32fc_x2_dot_prod_32fc_u_avx(lv_32fc_t* result, const lv_
 #endif /*LV_HAVE_AVX*/
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+
+#include <immintrin.h>
+
+static inline void volk_32fc_x2_dot_prod_32fc_u_avx2_fma(lv_32fc_t* result, const lv_32fc_t* input, const lv_32fc_t* taps, unsigned int num_points) {
+
+  unsigned int isodd = num_points & 3;
+  unsigned int i = 0;
+  lv_32fc_t dotProduct;
+  memset(&dotProduct, 0x0, 2*sizeof(float));
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m256 x, y, z, sumLow, sumHigh;
+
+  const lv_32fc_t* a = input;
+  const lv_32fc_t* b = taps;
+
+  sumLow = _mm256_setzero_ps(); // ar*cr, ai*cr, ...
+  sumHigh = _mm256_setzero_ps(); // ai*ci, ar*ci, ...
+
+  // The addsub of the complex multiply is linear, so the real and
+  // imaginary cross terms are accumulated separately and combined once.
+  for(;number < quarterPoints; number++){
+    x = _mm256_loadu_ps((float*)a); // Load a,b,e,f as ar,ai,br,bi,er,ei,fr,fi
+    y = _mm256_loadu_ps((float*)b); // Load c,d,g,h as cr,ci,dr,di,gr,gi,hr,hi
+
+    sumLow = _mm256_fmadd_ps(x, _mm256_moveldup_ps(y), sumLow);
+    sumHigh = _mm256_fmadd_ps(_mm256_permute_ps(x, 0xB1), _mm256_movehdup_ps(y), sumHigh);
+
+    a += 4;
+    b += 4;
+  }
+
+  z = _mm256_addsub_ps(sumLow, sumHigh); // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+  __VOLK_ATTR_ALIGNED(32) lv_32fc_t dotProductVector[4];
+
+  _mm256_store_ps((float*)dotProductVector,z); // Store the results back into the dot product vector
+
+  dotProduct += ( dotProductVector[0] + dotProductVector[1] + dotProductVector[2] + dotProductVector[3]);
+
+  for(i = num_points-isodd; i < num_points; i++) {
+    dotProduct += input[i] * taps[i];
+  }
+
+  *result = dotProduct;
+}
+
+#endif /*LV_HAVE_AVX2 && LV_HAVE_FMA*/
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void volk_32fc_x2_dot_prod_32fc_u_avx512f(lv_32fc_t* result, const lv_32fc_t* input, const lv_32fc_t* taps, unsigned int num_points) {
+
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+
+  __m512 x, y, sumLow, sumHigh, z;
+
+  const lv_32fc_t* a = input;
+  const lv_32fc_t* b = taps;
+
+  // The cross terms are kept in two accumulators and only combined with
+  // the add/subtract once, after the loop.
+  sumLow = _mm512_setzero_ps();  // ar*cr, ai*cr, ...
+  sumHigh = _mm512_setzero_ps(); // ai*ci, ar*ci, ...
+
+  for(;number < eighthPoints; number++){
+    x = _mm512_loadu_ps((float*)a); // Load a,b,... as ar,ai,br,bi,...
+    y = _mm512_loadu_ps((float*)b); // Load c,d,... as cr,ci,dr,di,...
+
+    sumLow = _mm512_fmadd_ps(x, _mm512_moveldup_ps(y), sumLow);
+    sumHigh = _mm512_fmadd_ps(_mm512_permute_ps(x, 0xB1), _mm512_movehdup_ps(y), sumHigh);
+
+    a += 8;
+    b += 8;
+  }
+
+  // Masked-off lanes load as zero and do not contribute to the sum
+  const __mmask16 tailMask = _mm512_tailmask_ps(2 * (num_points % 8));
+  x = _mm512_maskz_loadu_ps(tailMask, (float*)a);
+  y = _mm512_maskz_loadu_ps(tailMask, (float*)b);
+  sumLow = _mm512_fmadd_ps(x, _mm512_moveldup_ps(y), sumLow);
+  sumHigh = _mm512_fmadd_ps(_mm512_permute_ps(x, 0xB1), _mm512_movehdup_ps(y), sumHigh);
+
+  z = _mm512_fmaddsub_ps(sumLow, _mm512_set1_ps(1.0f), sumHigh); // real lanes subtract, imag lanes add
+
+  *result = lv_cmake(_mm512_mask_reduce_add_ps(0x5555, z),
+                     _mm512_mask_reduce_add_ps(0xAAAA, z));
+}
+
+#endif /*LV_HAVE_AVX512F*/
+
+
 #endif /*INCLUDED_volk_32fc_x2_dot_prod_32fc_u_H*/
 
 #ifndef INCLUDED_volk_32fc_x2_dot_prod_32fc_a_H
@@ -1148,4 +1247,103 @@ static inline void volk_32fc_x2_dot_prod_32fc_a_avx(lv_32fc_t* result, const lv_
 
 #endif /*LV_HAVE_AVX*/
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+
+#include <immintrin.h>
+
+static inline void volk_32fc_x2_dot_prod_32fc_a_avx2_fma(lv_32fc_t* result, const lv_32fc_t* input, const lv_32fc_t* taps, unsigned int num_points) {
+
+  unsigned int isodd = num_points & 3;
+  unsigned int i = 0;
+  lv_32fc_t dotProduct;
+  memset(&dotProduct, 0x0, 2*sizeof(float));
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m256 x, y, z, sumLow, sumHigh;
+
+  const lv_32fc_t* a = input;
+  const lv_32fc_t* b = taps;
+
+  sumLow = _mm256_setzero_ps(); // ar*cr, ai*cr, ...
+  sumHigh = _mm256_setzero_ps(); // ai*ci, ar*ci, ...
+
+  // The addsub of the complex multiply is linear, so the real and
+  // imaginary cross terms are accumulated separately and combined once.
+  for(;number < quarterPoints; number++){
+    x = _mm256_load_ps((float*)a); // Load a,b,e,f as ar,ai,br,bi,er,ei,fr,fi
+    y = _mm256_load_ps((float*)b); // Load c,d,g,h as cr,ci,dr,di,gr,gi,hr,hi
+
+    sumLow = _mm256_fmadd_ps(x, _mm256_moveldup_ps(y), sumLow);
+    sumHigh = _mm256_fmadd_ps(_mm256_permute_ps(x, 0xB1), _mm256_movehdup_ps(y), sumHigh);
+
+    a += 4;
+    b += 4;
+  }
+
+  z = _mm256_addsub_ps(sumLow, sumHigh); // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+  __VOLK_ATTR_ALIGNED(32) lv_32fc_t dotProductVector[4];
+
+  _mm256_store_ps((float*)dotProductVector,z); // Store the results back into the dot product vector
+
+  dotProduct += ( dotProductVector[0] + dotProductVector[1] + dotProductVector[2] + dotProductVector[3]);
+
+  for(i = num_points-isodd; i < num_points; i++) {
+    dotProduct += input[i] * taps[i];
+  }
+
+  *result = dotProduct;
+}
+
+#endif /*LV_HAVE_AVX2 && LV_HAVE_FMA*/
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void volk_32fc_x2_dot_prod_32fc_a_avx512f(lv_32fc_t* result, const lv_32fc_t* input, const lv_32fc_t* taps, unsigned int num_points) {
+
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+
+  __m512 x, y, sumLow, sumHigh, z;
+
+  const lv_32fc_t* a = input;
+  const lv_32fc_t* b = taps;
+
+  // The cross terms are kept in two accumulators and only combined with
+  // the add/subtract once, after the loop.
+  sumLow = _mm512_setzero_ps();  // ar*cr, ai*cr, ...
+  sumHigh = _mm512_setzero_ps(); // ai*ci, ar*ci, ...
+
+  for(;number < eighthPoints; number++){
+    x = _mm512_load_ps((float*)a); // Load a,b,... as ar,ai,br,bi,...
+    y = _mm512_load_ps((float*)b); // Load c,d,... as cr,ci,dr,di,...
+
+    sumLow = _mm512_fmadd_ps(x, _mm512_moveldup_ps(y), sumLow);
+    sumHigh = _mm512_fmadd_ps(_mm512_permute_ps(x, 0xB1), _mm512_movehdup_ps(y), sumHigh);
+
+    a += 8;
+    b += 8;
+  }
+
+  // Masked-off lanes load as zero and do not contribute to the sum
+  const __mmask16 tailMask = _mm512_tailmask_ps(2 * (num_points % 8));
+  x = _mm512_maskz_load_ps(tailMask, (float*)a);
+  y = _mm512_maskz_load_ps(tailMask, (float*)b);
+  sumLow = _mm512_fmadd_ps(x, _mm512_moveldup_ps(y), sumLow);
+  sumHigh = _mm512_fmadd_ps(_mm512_permute_ps(x, 0xB1), _mm512_movehdup_ps(y), sumHigh);
+
+  z = _mm512_fmaddsub_ps(sumLow, _mm512_set1_ps(1.0f), sumHigh); // real lanes subtract, imag lanes add
+
+  *result = lv_cmake(_mm512_mask_reduce_add_ps(0x5555, z),
+                     _mm512_mask_reduce_add_ps(0xAAAA, z));
+}
+
+#endif /*LV_HAVE_AVX512F*/
+
+
 #endif /*INCLUDED_volk_32fc_x2_dot_prod_32fc_a_H*/
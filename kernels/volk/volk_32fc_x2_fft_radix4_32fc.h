@@ -0,0 +1,399 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*!
+ * \page volk_32fc_x2_fft_radix4_32fc
+ *
+ * \b Overview
+ *
+ * One pass of a forward Stockham FFT over \p num_points samples, a
+ * power of two. A transform runs the pass with stride 1, 4, 16, ...,
+ * ping-ponging between two buffers, and the last pass leaves the
+ * spectrum in natural order without a bit reversal. While at least four
+ * points per butterfly remain the pass is radix-4; when num_points is
+ * an odd power of two the final pass, stride num_points / 2, is radix-2
+ * and uses no twiddles.
+ *
+ * With n = num_points / stride and m = n / 4, the radix-4 pass reads
+ * in[q + stride * (p + k * m)] for k = 0..3 and writes the butterfly
+ * outputs to out[q + stride * (4 * p + k)], the last three multiplied
+ * by W^p, W^2p and W^3p with W = exp(-2 pi j / n). Those twiddles come
+ * from \p twiddles as three runs of m values. fft_radix4_twiddles()
+ * lays out the runs of every pass of a transform back to back.
+ *
+ * volk_fft_plan_create() in volk/volk_fft.h strings the passes together;
+ * call the kernel directly only to build a different transform.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_32fc_x2_fft_radix4_32fc(lv_32fc_t* out, const lv_32fc_t* in, const lv_32fc_t* twiddles, unsigned int stride, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li in: the output of the previous pass, or the time samples
+ * \li twiddles: W^p, W^2p and W^3p for p < m, in that order
+ * \li stride: 1 for the first pass, four times the last stride after
+ * \li num_points: the transform size, a power of two of at least 64
+ *
+ * \b Outputs
+ * \li out: the pass output, which must not overlap \p in
+ *
+ * \b Example
+ * A 1024 point transform, five radix-4 passes.
+ * \code
+ * unsigned int N = 1024, stride;
+ * lv_32fc_t* tw = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t) * fft_radix4_twiddles_size(N), volk_get_alignment());
+ * lv_32fc_t* x = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t) * N, volk_get_alignment());
+ * lv_32fc_t* y = (lv_32fc_t*)volk_malloc(sizeof(lv_32fc_t) * N, volk_get_alignment());
+ * lv_32fc_t *src = x, *dst = y, *t = tw, *swap;
+ * fft_radix4_twiddles(tw, N);
+ *
+ * <populate x>
+ *
+ * for(stride = 1; stride < N; stride *= 4){
+ *   volk_32fc_x2_fft_radix4_32fc(dst, src, t, stride, N);
+ *   t += 3 * (N / stride / 4);
+ *   swap = src; src = dst; dst = swap;
+ * }
+ * //the spectrum is in src
+ *
+ * volk_free(tw);
+ * volk_free(x);
+ * volk_free(y);
+ * \endcode
+ */
+
+#ifndef INCLUDED_volk_32fc_x2_fft_radix4_32fc_u_H
+#define INCLUDED_volk_32fc_x2_fft_radix4_32fc_u_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#include <math.h>
+
+//twiddles every pass of a num_points transform reads, pass after pass
+static inline unsigned int
+fft_radix4_twiddles_size(unsigned int num_points)
+{
+  unsigned int n, size = 0;
+  for(n = num_points; n >= 4; n /= 4)
+    size += 3 * (n / 4);
+  return size;
+}
+
+static inline void
+fft_radix4_twiddles(lv_32fc_t* twiddles, unsigned int num_points)
+{
+  unsigned int n, m, p, k;
+  double w;
+  for(n = num_points; n >= 4; n /= 4){
+    m = n / 4;
+    for(k = 1; k <= 3; k++){
+      for(p = 0; p < m; p++){
+        w = -2.0 * M_PI * (double)(k * p) / (double)n;
+        *twiddles++ = lv_cmake((float)cos(w), (float)sin(w));
+      }
+    }
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_32fc_x2_fft_radix4_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, const lv_32fc_t* twiddles,
+                                     unsigned int stride, unsigned int num_points)
+{
+  const unsigned int s = stride;
+  const unsigned int m = num_points / stride / 4;
+  lv_32fc_t a, b, c, d, apc, amc, bpd, jbmd;
+  unsigned int p, q;
+
+  if(m == 0){
+    for(q = 0; q < s; q++){
+      a = in[q];
+      b = in[q + s];
+      out[q] = a + b;
+      out[q + s] = a - b;
+    }
+    return;
+  }
+
+  for(p = 0; p < m; p++){
+    const lv_32fc_t w1 = twiddles[p];
+    const lv_32fc_t w2 = twiddles[m + p];
+    const lv_32fc_t w3 = twiddles[2 * m + p];
+    for(q = 0; q < s; q++){
+      a = in[q + s * p];
+      b = in[q + s * (p + m)];
+      c = in[q + s * (p + 2 * m)];
+      d = in[q + s * (p + 3 * m)];
+      apc = a + c;
+      amc = a - c;
+      bpd = b + d;
+      jbmd = lv_cmake(lv_cimag(b - d), -lv_creal(b - d)); //-j * (b - d)
+      out[q + s * (4 * p)] = apc + bpd;
+      out[q + s * (4 * p + 1)] = (amc + jbmd) * w1;
+      out[q + s * (4 * p + 2)] = (apc - bpd) * w2;
+      out[q + s * (4 * p + 3)] = (amc - jbmd) * w3;
+    }
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+#include <volk/volk_sse3_intrinsics.h>
+
+static inline void
+volk_32fc_x2_fft_radix4_32fc_u_sse3(lv_32fc_t* out, const lv_32fc_t* in, const lv_32fc_t* twiddles,
+                                    unsigned int stride, unsigned int num_points)
+{
+  const unsigned int s = stride;
+  const unsigned int m = num_points / stride / 4;
+  const __m128 neg_imag = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+  const float* inPtr = (const float*)in;
+  float* outPtr = (float*)out;
+  __m128 a, b, c, d, apc, amc, bpd, jbmd, w1, w2, w3, y0, y1, y2, y3;
+  unsigned int p, q;
+
+  //two points per register, so every stride here is a whole number of them
+  if(m == 0){
+    for(q = 0; q < s; q += 2){
+      a = _mm_loadu_ps(inPtr + 2 * q);
+      b = _mm_loadu_ps(inPtr + 2 * (q + s));
+      _mm_storeu_ps(outPtr + 2 * q, _mm_add_ps(a, b));
+      _mm_storeu_ps(outPtr + 2 * (q + s), _mm_sub_ps(a, b));
+    }
+    return;
+  }
+
+  if(s == 1){
+    //first pass: vectorise over p, then interleave the four outputs
+    for(p = 0; p < m; p += 2){
+      a = _mm_loadu_ps(inPtr + 2 * p);
+      b = _mm_loadu_ps(inPtr + 2 * (p + m));
+      c = _mm_loadu_ps(inPtr + 2 * (p + 2 * m));
+      d = _mm_loadu_ps(inPtr + 2 * (p + 3 * m));
+      apc = _mm_add_ps(a, c);
+      amc = _mm_sub_ps(a, c);
+      bpd = _mm_add_ps(b, d);
+      jbmd = _mm_sub_ps(b, d);
+      jbmd = _mm_xor_ps(_mm_shuffle_ps(jbmd, jbmd, 0xB1), neg_imag);
+      y0 = _mm_add_ps(apc, bpd);
+      y1 = _mm_complexmul_ps(_mm_add_ps(amc, jbmd), _mm_loadu_ps((const float*)(twiddles + p)));
+      y2 = _mm_complexmul_ps(_mm_sub_ps(apc, bpd), _mm_loadu_ps((const float*)(twiddles + m + p)));
+      y3 = _mm_complexmul_ps(_mm_sub_ps(amc, jbmd), _mm_loadu_ps((const float*)(twiddles + 2 * m + p)));
+      _mm_storeu_ps(outPtr + 8 * p, _mm_movelh_ps(y0, y1));
+      _mm_storeu_ps(outPtr + 8 * p + 4, _mm_movelh_ps(y2, y3));
+      _mm_storeu_ps(outPtr + 8 * p + 8, _mm_movehl_ps(y1, y0));
+      _mm_storeu_ps(outPtr + 8 * p + 12, _mm_movehl_ps(y3, y2));
+    }
+    return;
+  }
+
+  for(p = 0; p < m; p++){
+    w1 = _mm_castpd_ps(_mm_loaddup_pd((const double*)(twiddles + p)));
+    w2 = _mm_castpd_ps(_mm_loaddup_pd((const double*)(twiddles + m + p)));
+    w3 = _mm_castpd_ps(_mm_loaddup_pd((const double*)(twiddles + 2 * m + p)));
+    for(q = 0; q < s; q += 2){
+      a = _mm_loadu_ps(inPtr + 2 * (q + s * p));
+      b = _mm_loadu_ps(inPtr + 2 * (q + s * (p + m)));
+      c = _mm_loadu_ps(inPtr + 2 * (q + s * (p + 2 * m)));
+      d = _mm_loadu_ps(inPtr + 2 * (q + s * (p + 3 * m)));
+      apc = _mm_add_ps(a, c);
+      amc = _mm_sub_ps(a, c);
+      bpd = _mm_add_ps(b, d);
+      jbmd = _mm_sub_ps(b, d);
+      jbmd = _mm_xor_ps(_mm_shuffle_ps(jbmd, jbmd, 0xB1), neg_imag);
+      _mm_storeu_ps(outPtr + 2 * (q + s * (4 * p)), _mm_add_ps(apc, bpd));
+      _mm_storeu_ps(outPtr + 2 * (q + s * (4 * p + 1)), _mm_complexmul_ps(_mm_add_ps(amc, jbmd), w1));
+      _mm_storeu_ps(outPtr + 2 * (q + s * (4 * p + 2)), _mm_complexmul_ps(_mm_sub_ps(apc, bpd), w2));
+      _mm_storeu_ps(outPtr + 2 * (q + s * (4 * p + 3)), _mm_complexmul_ps(_mm_sub_ps(amc, jbmd), w3));
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+#include <volk/volk_avx_intrinsics.h>
+
+static inline void
+volk_32fc_x2_fft_radix4_32fc_u_avx(lv_32fc_t* out, const lv_32fc_t* in, const lv_32fc_t* twiddles,
+                                   unsigned int stride, unsigned int num_points)
+{
+  const unsigned int s = stride;
+  const unsigned int m = num_points / stride / 4;
+  const __m256 neg_imag = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+  const float* inPtr = (const float*)in;
+  float* outPtr = (float*)out;
+  __m256 a, b, c, d, apc, amc, bpd, jbmd, w1, w2, w3, y0, y1, y2, y3;
+  __m256d t0, t1, t2, t3;
+  unsigned int p, q;
+
+  //four points per register; the strides after the first are multiples of four
+  if(m == 0){
+    for(q = 0; q < s; q += 4){
+      a = _mm256_loadu_ps(inPtr + 2 * q);
+      b = _mm256_loadu_ps(inPtr + 2 * (q + s));
+      _mm256_storeu_ps(outPtr + 2 * q, _mm256_add_ps(a, b));
+      _mm256_storeu_ps(outPtr + 2 * (q + s), _mm256_sub_ps(a, b));
+    }
+    return;
+  }
+
+  if(s == 1){
+    //first pass: vectorise over p, then transpose the 4x4 block of outputs
+    for(p = 0; p < m; p += 4){
+      a = _mm256_loadu_ps(inPtr + 2 * p);
+      b = _mm256_loadu_ps(inPtr + 2 * (p + m));
+      c = _mm256_loadu_ps(inPtr + 2 * (p + 2 * m));
+      d = _mm256_loadu_ps(inPtr + 2 * (p + 3 * m));
+      apc = _mm256_add_ps(a, c);
+      amc = _mm256_sub_ps(a, c);
+      bpd = _mm256_add_ps(b, d);
+      jbmd = _mm256_sub_ps(b, d);
+      jbmd = _mm256_xor_ps(_mm256_permute_ps(jbmd, 0xB1), neg_imag);
+      y0 = _mm256_add_ps(apc, bpd);
+      y1 = _mm256_complexmul_ps(_mm256_add_ps(amc, jbmd), _mm256_loadu_ps((const float*)(twiddles + p)));
+      y2 = _mm256_complexmul_ps(_mm256_sub_ps(apc, bpd), _mm256_loadu_ps((const float*)(twiddles + m + p)));
+      y3 = _mm256_complexmul_ps(_mm256_sub_ps(amc, jbmd), _mm256_loadu_ps((const float*)(twiddles + 2 * m + p)));
+      t0 = _mm256_unpacklo_pd(_mm256_castps_pd(y0), _mm256_castps_pd(y1));
+      t1 = _mm256_unpackhi_pd(_mm256_castps_pd(y0), _mm256_castps_pd(y1));
+      t2 = _mm256_unpacklo_pd(_mm256_castps_pd(y2), _mm256_castps_pd(y3));
+      t3 = _mm256_unpackhi_pd(_mm256_castps_pd(y2), _mm256_castps_pd(y3));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p), _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p + 8), _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p + 16), _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p + 24), _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+    return;
+  }
+
+  for(p = 0; p < m; p++){
+    w1 = _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(twiddles + p)));
+    w2 = _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(twiddles + m + p)));
+    w3 = _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(twiddles + 2 * m + p)));
+    for(q = 0; q < s; q += 4){
+      a = _mm256_loadu_ps(inPtr + 2 * (q + s * p));
+      b = _mm256_loadu_ps(inPtr + 2 * (q + s * (p + m)));
+      c = _mm256_loadu_ps(inPtr + 2 * (q + s * (p + 2 * m)));
+      d = _mm256_loadu_ps(inPtr + 2 * (q + s * (p + 3 * m)));
+      apc = _mm256_add_ps(a, c);
+      amc = _mm256_sub_ps(a, c);
+      bpd = _mm256_add_ps(b, d);
+      jbmd = _mm256_sub_ps(b, d);
+      jbmd = _mm256_xor_ps(_mm256_permute_ps(jbmd, 0xB1), neg_imag);
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p)), _mm256_add_ps(apc, bpd));
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p + 1)), _mm256_complexmul_ps(_mm256_add_ps(amc, jbmd), w1));
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p + 2)), _mm256_complexmul_ps(_mm256_sub_ps(apc, bpd), w2));
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p + 3)), _mm256_complexmul_ps(_mm256_sub_ps(amc, jbmd), w3));
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32fc_x2_fft_radix4_32fc_u_avx2_fma(lv_32fc_t* out, const lv_32fc_t* in, const lv_32fc_t* twiddles,
+                                        unsigned int stride, unsigned int num_points)
+{
+  const unsigned int s = stride;
+  const unsigned int m = num_points / stride / 4;
+  const __m256 neg_imag = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+  const float* inPtr = (const float*)in;
+  float* outPtr = (float*)out;
+  __m256 a, b, c, d, apc, amc, bpd, jbmd, w1, w2, w3, y0, y1, y2, y3;
+  __m256d t0, t1, t2, t3;
+  unsigned int p, q;
+
+  if(m == 0){
+    for(q = 0; q < s; q += 4){
+      a = _mm256_loadu_ps(inPtr + 2 * q);
+      b = _mm256_loadu_ps(inPtr + 2 * (q + s));
+      _mm256_storeu_ps(outPtr + 2 * q, _mm256_add_ps(a, b));
+      _mm256_storeu_ps(outPtr + 2 * (q + s), _mm256_sub_ps(a, b));
+    }
+    return;
+  }
+
+  if(s == 1){
+    //first pass: vectorise over p, then transpose the 4x4 block of outputs
+    for(p = 0; p < m; p += 4){
+      a = _mm256_loadu_ps(inPtr + 2 * p);
+      b = _mm256_loadu_ps(inPtr + 2 * (p + m));
+      c = _mm256_loadu_ps(inPtr + 2 * (p + 2 * m));
+      d = _mm256_loadu_ps(inPtr + 2 * (p + 3 * m));
+      apc = _mm256_add_ps(a, c);
+      amc = _mm256_sub_ps(a, c);
+      bpd = _mm256_add_ps(b, d);
+      jbmd = _mm256_sub_ps(b, d);
+      jbmd = _mm256_xor_ps(_mm256_permute_ps(jbmd, 0xB1), neg_imag);
+      y0 = _mm256_add_ps(apc, bpd);
+      y1 = _mm256_complexmul_fma_ps(_mm256_add_ps(amc, jbmd), _mm256_loadu_ps((const float*)(twiddles + p)));
+      y2 = _mm256_complexmul_fma_ps(_mm256_sub_ps(apc, bpd), _mm256_loadu_ps((const float*)(twiddles + m + p)));
+      y3 = _mm256_complexmul_fma_ps(_mm256_sub_ps(amc, jbmd), _mm256_loadu_ps((const float*)(twiddles + 2 * m + p)));
+      t0 = _mm256_unpacklo_pd(_mm256_castps_pd(y0), _mm256_castps_pd(y1));
+      t1 = _mm256_unpackhi_pd(_mm256_castps_pd(y0), _mm256_castps_pd(y1));
+      t2 = _mm256_unpacklo_pd(_mm256_castps_pd(y2), _mm256_castps_pd(y3));
+      t3 = _mm256_unpackhi_pd(_mm256_castps_pd(y2), _mm256_castps_pd(y3));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p), _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p + 8), _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p + 16), _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd((double*)(outPtr + 8 * p + 24), _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+    return;
+  }
+
+  for(p = 0; p < m; p++){
+    w1 = _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(twiddles + p)));
+    w2 = _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(twiddles + m + p)));
+    w3 = _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(twiddles + 2 * m + p)));
+    for(q = 0; q < s; q += 4){
+      a = _mm256_loadu_ps(inPtr + 2 * (q + s * p));
+      b = _mm256_loadu_ps(inPtr + 2 * (q + s * (p + m)));
+      c = _mm256_loadu_ps(inPtr + 2 * (q + s * (p + 2 * m)));
+      d = _mm256_loadu_ps(inPtr + 2 * (q + s * (p + 3 * m)));
+      apc = _mm256_add_ps(a, c);
+      amc = _mm256_sub_ps(a, c);
+      bpd = _mm256_add_ps(b, d);
+      jbmd = _mm256_sub_ps(b, d);
+      jbmd = _mm256_xor_ps(_mm256_permute_ps(jbmd, 0xB1), neg_imag);
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p)), _mm256_add_ps(apc, bpd));
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p + 1)), _mm256_complexmul_fma_ps(_mm256_add_ps(amc, jbmd), w1));
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p + 2)), _mm256_complexmul_fma_ps(_mm256_sub_ps(apc, bpd), w2));
+      _mm256_storeu_ps(outPtr + 2 * (q + s * (4 * p + 3)), _mm256_complexmul_fma_ps(_mm256_sub_ps(amc, jbmd), w3));
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+#endif /* INCLUDED_volk_32fc_x2_fft_radix4_32fc_u_H */
@@ -123,6 +123,43 @@ static inline void volk_32fc_x2_multiply_32fc_u_avx2_fma(lv_32fc_t* cVector, con
 #endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
 
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void
+volk_32fc_x2_multiply_32fc_u_avx512f(lv_32fc_t* cVector, const lv_32fc_t* aVector,
+                                     const lv_32fc_t* bVector, unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+
+  __m512 x, y, z;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  for(; number < eighthPoints; number++){
+    x = _mm512_loadu_ps((float*) a); // Load the ar + ai, br + bi ... as ar,ai,br,bi ...
+    y = _mm512_loadu_ps((float*) b); // Load the cr + ci, dr + di ... as cr,ci,dr,di ...
+    z = _mm512_complexmul_ps(x, y);
+    _mm512_storeu_ps((float*) c, z); // Store the results back into the C container
+
+    a += 8;
+    b += 8;
+    c += 8;
+  }
+
+  // Each remaining complex point occupies two float lanes
+  const __mmask16 tailMask = _mm512_tailmask_ps(2 * (num_points % 8));
+  x = _mm512_maskz_loadu_ps(tailMask, (float*) a);
+  y = _mm512_maskz_loadu_ps(tailMask, (float*) b);
+  z = _mm512_complexmul_ps(x, y);
+  _mm512_mask_storeu_ps((float*) c, tailMask, z);
+}
+#endif /* LV_HAVE_AVX512F */
+
+
 #ifdef LV_HAVE_AVX
 #include <immintrin.h>
 #include <volk/volk_avx_intrinsics.h>
@@ -268,6 +305,43 @@ static inline void volk_32fc_x2_multiply_32fc_a_avx2_fma(lv_32fc_t* cVector, con
 #endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
 
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+#include <volk/volk_avx512_intrinsics.h>
+
+static inline void
+volk_32fc_x2_multiply_32fc_a_avx512f(lv_32fc_t* cVector, const lv_32fc_t* aVector,
+                                     const lv_32fc_t* bVector, unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int eighthPoints = num_points / 8;
+
+  __m512 x, y, z;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  for(; number < eighthPoints; number++){
+    x = _mm512_load_ps((float*) a); // Load the ar + ai, br + bi ... as ar,ai,br,bi ...
+    y = _mm512_load_ps((float*) b); // Load the cr + ci, dr + di ... as cr,ci,dr,di ...
+    z = _mm512_complexmul_ps(x, y);
+    _mm512_store_ps((float*) c, z); // Store the results back into the C container
+
+    a += 8;
+    b += 8;
+    c += 8;
+  }
+
+  // Each remaining complex point occupies two float lanes
+  const __mmask16 tailMask = _mm512_tailmask_ps(2 * (num_points % 8));
+  x = _mm512_maskz_load_ps(tailMask, (float*) a);
+  y = _mm512_maskz_load_ps(tailMask, (float*) b);
+  z = _mm512_complexmul_ps(x, y);
+  _mm512_mask_store_ps((float*) c, tailMask, z);
+}
+#endif /* LV_HAVE_AVX512F */
+
+
 #ifdef LV_HAVE_AVX
 #include <immintrin.h>
 #include <volk/volk_avx_intrinsics.h>
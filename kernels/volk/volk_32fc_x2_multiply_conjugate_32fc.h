@@ -112,6 +112,42 @@ volk_32fc_x2_multiply_conjugate_32fc_u_avx(lv_32fc_t* cVector, const lv_32fc_t*
 #endif /* LV_HAVE_AVX */
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32fc_x2_multiply_conjugate_32fc_u_avx2_fma(lv_32fc_t* cVector, const lv_32fc_t* aVector,
+                                                const lv_32fc_t* bVector, unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m256 x, y, z;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  for(; number < quarterPoints; number++){
+    x = _mm256_loadu_ps((float*) a); // Load the ar + ai, br + bi ... as ar,ai,br,bi ...
+    y = _mm256_loadu_ps((float*) b); // Load the cr + ci, dr + di ... as cr,ci,dr,di ...
+    z = _mm256_complexconjugatemul_fma_ps(x, y);
+    _mm256_storeu_ps((float*) c, z); // Store the results back into the C container
+
+    a += 4;
+    b += 4;
+    c += 4;
+  }
+
+  number = quarterPoints * 4;
+
+  for(; number < num_points; number++){
+    *c++ = (*a++) * lv_conj(*b++);
+  }
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+
 #ifdef LV_HAVE_SSE3
 #include <pmmintrin.h>
 #include <volk/volk_sse3_intrinsics.h>
@@ -210,6 +246,42 @@ volk_32fc_x2_multiply_conjugate_32fc_a_avx(lv_32fc_t* cVector, const lv_32fc_t*
 #endif /* LV_HAVE_AVX */
 
 
+#if LV_HAVE_AVX2 && LV_HAVE_FMA
+#include <immintrin.h>
+#include <volk/volk_avx2_fma_intrinsics.h>
+
+static inline void
+volk_32fc_x2_multiply_conjugate_32fc_a_avx2_fma(lv_32fc_t* cVector, const lv_32fc_t* aVector,
+                                                const lv_32fc_t* bVector, unsigned int num_points)
+{
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m256 x, y, z;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  for(; number < quarterPoints; number++){
+    x = _mm256_load_ps((float*) a); // Load the ar + ai, br + bi ... as ar,ai,br,bi ...
+    y = _mm256_load_ps((float*) b); // Load the cr + ci, dr + di ... as cr,ci,dr,di ...
+    z = _mm256_complexconjugatemul_fma_ps(x, y);
+    _mm256_store_ps((float*) c, z); // Store the results back into the C container
+
+    a += 4;
+    b += 4;
+    c += 4;
+  }
+
+  number = quarterPoints * 4;
+
+  for(; number < num_points; number++){
+    *c++ = (*a++) * lv_conj(*b++);
+  }
+}
+#endif /* LV_HAVE_AVX2 && LV_HAVE_FMA */
+
+
 #ifdef LV_HAVE_SSE3
 #include <pmmintrin.h>
 #include <volk/volk_sse3_intrinsics.h>
@@ -54,6 +54,8 @@
 #ifndef INCLUDED_volk_8ic_deinterleave_16i_x2_a_H
 #define INCLUDED_volk_8ic_deinterleave_16i_x2_a_H
 
+#define volk_8ic_deinterleave_16i_x2_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 
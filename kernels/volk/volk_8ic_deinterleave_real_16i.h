@@ -53,6 +53,8 @@
 #ifndef INCLUDED_volk_8ic_deinterleave_real_16i_a_H
 #define INCLUDED_volk_8ic_deinterleave_real_16i_a_H
 
+#define volk_8ic_deinterleave_real_16i_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 
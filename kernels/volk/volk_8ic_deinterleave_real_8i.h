@@ -53,6 +53,8 @@
 #ifndef INCLUDED_VOLK_8sc_DEINTERLEAVE_REAL_8s_ALIGNED8_H
 #define INCLUDED_VOLK_8sc_DEINTERLEAVE_REAL_8s_ALIGNED8_H
 
+#define volk_8ic_deinterleave_real_8i_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 
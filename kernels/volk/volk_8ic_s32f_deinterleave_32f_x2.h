@@ -56,6 +56,8 @@
 #ifndef INCLUDED_volk_8ic_s32f_deinterleave_32f_x2_a_H
 #define INCLUDED_volk_8ic_s32f_deinterleave_32f_x2_a_H
 
+#define volk_8ic_s32f_deinterleave_32f_x2_peelable
+
 #include <volk/volk_common.h>
 #include <inttypes.h>
 #include <stdio.h>
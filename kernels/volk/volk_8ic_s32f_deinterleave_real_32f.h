@@ -55,6 +55,8 @@
 #ifndef INCLUDED_volk_8ic_s32f_deinterleave_real_32f_a_H
 #define INCLUDED_volk_8ic_s32f_deinterleave_real_32f_a_H
 
+#define volk_8ic_s32f_deinterleave_real_32f_peelable
+
 #include <volk/volk_common.h>
 #include <inttypes.h>
 #include <stdio.h>
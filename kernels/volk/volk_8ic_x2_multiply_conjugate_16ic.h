@@ -23,6 +23,8 @@
 #ifndef INCLUDED_volk_8ic_x2_multiply_conjugate_16ic_a_H
 #define INCLUDED_volk_8ic_x2_multiply_conjugate_16ic_a_H
 
+#define volk_8ic_x2_multiply_conjugate_16ic_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 #include <volk/volk_complex.h>
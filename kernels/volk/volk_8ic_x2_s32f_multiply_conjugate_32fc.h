@@ -56,6 +56,8 @@
 #ifndef INCLUDED_volk_8ic_x2_s32f_multiply_conjugate_32fc_a_H
 #define INCLUDED_volk_8ic_x2_s32f_multiply_conjugate_32fc_a_H
 
+#define volk_8ic_x2_s32f_multiply_conjugate_32fc_peelable
+
 #include <inttypes.h>
 #include <stdio.h>
 #include <volk/volk_complex.h>
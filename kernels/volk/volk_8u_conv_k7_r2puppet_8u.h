@@ -40,6 +40,44 @@ static inline int parity(int x, unsigned char* Partab)
   return Partab[x];
 }
 
+//the branch table for the (79, 109) code the puppet decodes; it is the
+//same for every call, so each thread fills its own copy once and the
+//timed calls only run the decoder
+static inline unsigned char* conv_k7_r2puppet_branchtab(void)
+{
+  static __VOLK_THREAD_LOCAL __VOLK_ATTR_ALIGNED(64) unsigned char Branchtab[(1 << 6) / 2 * 2];
+  static __VOLK_THREAD_LOCAL int ready = 0;
+  int d_numstates = (1 << 6);
+  int rate = 2;
+  int d_polys[2] = {79, 109};
+  unsigned char Partab[256];
+  int state, i;
+  int cnt,ti;
+
+  if(ready)
+    return Branchtab;
+
+  /* Initialize parity lookup table */
+  for(i=0;i<256;i++){
+    cnt = 0;
+    ti = i;
+    while(ti){
+      if(ti & 1)
+        cnt++;
+      ti >>= 1;
+    }
+    Partab[i] = cnt & 1;
+  }
+  /*  Initialize the branch table */
+  for(state=0;state < d_numstates/2;state++){
+    for(i=0; i<rate; i++){
+      Branchtab[i*d_numstates/2+state] = (d_polys[i] < 0) ^ parity((2*state) & abs(d_polys[i]), Partab) ? 255 : 0;
+    }
+  }
+  ready = 1;
+  return Branchtab;
+}
+
 static inline int chainback_viterbi(unsigned char* data,
                                     unsigned int nbits,
                                     unsigned int endstate,
@@ -115,48 +153,19 @@ static inline int chainback_viterbi(unsigned char* data,
 
 static inline void volk_8u_conv_k7_r2puppet_8u_spiral(unsigned char* syms, unsigned char* dec, unsigned int framebits) {
 
-
-  static int once = 1;
   int d_numstates = (1 << 6);
-  int rate = 2;
-  static unsigned char* D;
-  static unsigned char* Y;
-  static unsigned char* X;
-  static unsigned int excess = 6;
-  static unsigned char* Branchtab;
-  static unsigned char Partab[256];
-
-  int d_polys[2] = {79, 109};
-
-
-  if(once) {
-
-    X = (unsigned char*)volk_malloc(2*d_numstates, volk_get_alignment());
-    Y = X + d_numstates;
-    Branchtab = (unsigned char*)volk_malloc(d_numstates/2*rate, volk_get_alignment());
-    D = (unsigned char*)volk_malloc((d_numstates/8) * (framebits + 6), volk_get_alignment());
-    int state, i;
-    int cnt,ti;
-
-    /* Initialize parity lookup table */
-    for(i=0;i<256;i++){
-      cnt = 0;
-      ti = i;
-      while(ti){
-        if(ti & 1)
-          cnt++;
-        ti >>= 1;
-      }
-      Partab[i] = cnt & 1;
-    }
-    /*  Initialize the branch table */
-    for(state=0;state < d_numstates/2;state++){
-      for(i=0; i<rate; i++){
-        Branchtab[i*d_numstates/2+state] = (d_polys[i] < 0) ^ parity((2*state) & abs(d_polys[i]), Partab) ? 255 : 0;
-      }
-    }
-
-    once = 0;
+  unsigned int excess = 6;
+  size_t mark = volk_scratch_mark();
+  unsigned char* X = (unsigned char*)volk_scratch_get(2*d_numstates, volk_get_alignment());
+  unsigned char* Y = X + d_numstates;
+  unsigned char* D = (unsigned char*)volk_scratch_get((d_numstates/8) * (framebits + 6), volk_get_alignment());
+  unsigned char* Branchtab = conv_k7_r2puppet_branchtab();
+
+  //no scratch to decode into; leave nothing decoded
+  if(X == NULL || D == NULL) {
+    memset(dec, 0, framebits/2 - excess);
+    volk_scratch_release(mark);
+    return;
   }
 
     //unbias the old_metrics
@@ -175,6 +184,7 @@ static inline void volk_8u_conv_k7_r2puppet_8u_spiral(unsigned char* syms, unsig
 
   chainback_viterbi(dec, framebits/2 -excess, state, excess, D);
 
+  volk_scratch_release(mark);
   return;
 }
 
@@ -190,49 +200,19 @@ static inline void volk_8u_conv_k7_r2puppet_8u_spiral(unsigned char* syms, unsig
 static inline void volk_8u_conv_k7_r2puppet_8u_generic(unsigned char* syms, unsigned char* dec, unsigned int framebits) {
 
 
-
-  static int once = 1;
   int d_numstates = (1 << 6);
-  int rate = 2;
-  static unsigned char* Y;
-  static unsigned char* X;
-  static unsigned char* D;
-  static unsigned int excess = 6;
-  static unsigned char* Branchtab;
-  static unsigned char Partab[256];
-
-  int d_polys[2] = {79, 109};
-
-
-  if(once) {
-
-    X = (unsigned char*)volk_malloc(2*d_numstates, volk_get_alignment());
-    Y = X + d_numstates;
-    Branchtab = (unsigned char*)volk_malloc(d_numstates/2*rate, volk_get_alignment());
-    D = (unsigned char*)volk_malloc((d_numstates/8) * (framebits + 6), volk_get_alignment());
-
-    int state, i;
-    int cnt,ti;
-
-    /* Initialize parity lookup table */
-    for(i=0;i<256;i++){
-      cnt = 0;
-      ti = i;
-      while(ti){
-        if(ti & 1)
-          cnt++;
-        ti >>= 1;
-      }
-      Partab[i] = cnt & 1;
-    }
-    /*  Initialize the branch table */
-    for(state=0;state < d_numstates/2;state++){
-      for(i=0; i<rate; i++){
-        Branchtab[i*d_numstates/2+state] = (d_polys[i] < 0) ^ parity((2*state) & abs(d_polys[i]), Partab) ? 255 : 0;
-      }
-    }
-
-    once = 0;
+  unsigned int excess = 6;
+  size_t mark = volk_scratch_mark();
+  unsigned char* X = (unsigned char*)volk_scratch_get(2*d_numstates, volk_get_alignment());
+  unsigned char* Y = X + d_numstates;
+  unsigned char* D = (unsigned char*)volk_scratch_get((d_numstates/8) * (framebits + 6), volk_get_alignment());
+  unsigned char* Branchtab = conv_k7_r2puppet_branchtab();
+
+  //no scratch to decode into; leave nothing decoded
+  if(X == NULL || D == NULL) {
+    memset(dec, 0, framebits/2 - excess);
+    volk_scratch_release(mark);
+    return;
   }
 
 
@@ -254,6 +234,7 @@ static inline void volk_8u_conv_k7_r2puppet_8u_generic(unsigned char* syms, unsi
 
   chainback_viterbi(dec, framebits/2 -excess, state, excess, D);
 
+  volk_scratch_release(mark);
   return;
 
 
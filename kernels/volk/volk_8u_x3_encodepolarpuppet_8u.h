@@ -28,6 +28,7 @@
 #define VOLK_KERNELS_VOLK_VOLK_8U_X3_ENCODEPOLARPUPPET_8U_H_
 #include <volk/volk.h>
 #include <volk/volk_8u_x3_encodepolar_8u_x2.h>
+#include <string.h>
 
 static inline unsigned int
 next_lower_power_of_two(const unsigned int val)
@@ -61,10 +62,16 @@ volk_8u_x3_encodepolarpuppet_8u_generic(unsigned char* frame, unsigned char* fro
     unsigned int frame_size)
 {
   frame_size = next_lower_power_of_two(frame_size);
-  unsigned char* temp = (unsigned char*) volk_malloc(sizeof(unsigned char) * frame_size, volk_get_alignment());
+  size_t mark = volk_scratch_mark();
+  unsigned char* temp = (unsigned char*) volk_scratch_get(sizeof(unsigned char) * frame_size, volk_get_alignment());
+  if(temp == NULL){
+    memset(frame, 0, frame_size);
+    volk_scratch_release(mark);
+    return;
+  }
   adjust_frozen_mask(frozen_bit_mask, frame_size);
   volk_8u_x3_encodepolar_8u_x2_generic(frame, temp, frozen_bit_mask, frozen_bits, info_bits, frame_size);
-  volk_free(temp);
+  volk_scratch_release(mark);
 }
 #endif /* LV_HAVE_GENERIC */
 
@@ -76,10 +83,16 @@ volk_8u_x3_encodepolarpuppet_8u_u_ssse3(unsigned char* frame, unsigned char* fro
     unsigned int frame_size)
 {
   frame_size = next_lower_power_of_two(frame_size);
-  unsigned char* temp = (unsigned char*) volk_malloc(sizeof(unsigned char) * frame_size, volk_get_alignment());
+  size_t mark = volk_scratch_mark();
+  unsigned char* temp = (unsigned char*) volk_scratch_get(sizeof(unsigned char) * frame_size, volk_get_alignment());
+  if(temp == NULL){
+    memset(frame, 0, frame_size);
+    volk_scratch_release(mark);
+    return;
+  }
   adjust_frozen_mask(frozen_bit_mask, frame_size);
   volk_8u_x3_encodepolar_8u_x2_u_ssse3(frame, temp, frozen_bit_mask, frozen_bits, info_bits, frame_size);
-  volk_free(temp);
+  volk_scratch_release(mark);
 }
 #endif /* LV_HAVE_SSSE3 */
 
@@ -95,10 +108,16 @@ volk_8u_x3_encodepolarpuppet_8u_a_ssse3(unsigned char* frame, unsigned char* fro
     unsigned int frame_size)
 {
   frame_size = next_lower_power_of_two(frame_size);
-  unsigned char* temp = (unsigned char*) volk_malloc(sizeof(unsigned char) * frame_size, volk_get_alignment());
+  size_t mark = volk_scratch_mark();
+  unsigned char* temp = (unsigned char*) volk_scratch_get(sizeof(unsigned char) * frame_size, volk_get_alignment());
+  if(temp == NULL){
+    memset(frame, 0, frame_size);
+    volk_scratch_release(mark);
+    return;
+  }
   adjust_frozen_mask(frozen_bit_mask, frame_size);
   volk_8u_x3_encodepolar_8u_x2_a_ssse3(frame, temp, frozen_bit_mask, frozen_bits, info_bits, frame_size);
-  volk_free(temp);
+  volk_scratch_release(mark);
 }
 #endif /* LV_HAVE_SSSE3 */
 
@@ -59,13 +59,13 @@ std::vector<volk_test_case_t> init_test_list(volk_test_params_t test_params)
         (VOLK_INIT_TEST(volk_32fc_32f_multiply_32fc,                    test_params))
         (VOLK_INIT_TEST(volk_32f_log2_32f,           volk_test_params_t(3, test_params.scalar(), test_params.vlen(), test_params.iter(), test_params.benchmark_mode(), test_params.kernel_regex())))
         (VOLK_INIT_TEST(volk_32f_expfast_32f,        volk_test_params_t(1e-1, test_params.scalar(), test_params.vlen(), test_params.iter(), test_params.benchmark_mode(), test_params.kernel_regex())))
-        (VOLK_INIT_TEST(volk_32f_x2_pow_32f,         volk_test_params_t(1e-2, test_params.scalar(), test_params.vlen(), test_params.iter(), test_params.benchmark_mode(), test_params.kernel_regex())))
-        (VOLK_INIT_TEST(volk_32f_sin_32f,                               test_params_inacc))
-        (VOLK_INIT_TEST(volk_32f_cos_32f,                               test_params_inacc))
-        (VOLK_INIT_TEST(volk_32f_tan_32f,                               test_params_inacc))
-        (VOLK_INIT_TEST(volk_32f_atan_32f,                              test_params_inacc))
-        (VOLK_INIT_TEST(volk_32f_asin_32f,                              test_params_inacc))
-        (VOLK_INIT_TEST(volk_32f_acos_32f,                              test_params_inacc))
+        (VOLK_INIT_TEST(volk_32f_x2_pow_32f,         test_params.make_tol(5e-3)))
+        (VOLK_INIT_TEST(volk_32f_sin_32f,            test_params.make_tol(1e-5)))
+        (VOLK_INIT_TEST(volk_32f_cos_32f,            test_params.make_tol(1e-5)))
+        (VOLK_INIT_TEST(volk_32f_tan_32f,            test_params.make_tol(1e-5)))
+        (VOLK_INIT_TEST(volk_32f_atan_32f,           test_params.make_tol(1e-3)))
+        (VOLK_INIT_TEST(volk_32f_asin_32f,           test_params.make_tol(1e-3)))
+        (VOLK_INIT_TEST(volk_32f_acos_32f,           test_params.make_tol(1e-3)))
         (VOLK_INIT_TEST(volk_32fc_s32f_power_32fc,                      test_params))
         (VOLK_INIT_TEST(volk_32f_s32f_calc_spectral_noise_floor_32f,    test_params_inacc))
         (VOLK_INIT_TEST(volk_32fc_s32f_atan2_32f,                       test_params))
@@ -133,6 +133,12 @@ std::vector<volk_test_case_t> init_test_list(volk_test_params_t test_params)
         (VOLK_INIT_TEST(volk_32f_s32f_mod_rangepuppet_32f,              test_params))
         (VOLK_INIT_PUPP(volk_8u_x3_encodepolarpuppet_8u, volk_8u_x3_encodepolar_8u_x2, test_params))
         (VOLK_INIT_PUPP(volk_32f_8u_polarbutterflypuppet_32f, volk_32f_8u_polarbutterfly_32f, test_params))
+        (VOLK_INIT_PUPP(volk_32fc_32f_fir_decimpuppet_32fc, volk_32fc_32f_fir_decim_32fc, test_params_inacc))
+        (VOLK_INIT_PUPP(volk_32fc_32f_pfb_resamppuppet_32fc, volk_32fc_32f_pfb_resamp_32fc, test_params_inacc))
+        (VOLK_INIT_PUPP(volk_32fc_fft_radix4puppet_32fc, volk_32fc_x2_fft_radix4_32fc, test_params_inacc))
+        (VOLK_INIT_TEST(volk_32f_sincos_32f_x2, test_params))
+        (VOLK_INIT_TEST(volk_32f_expj_32fc, test_params))
+        (VOLK_INIT_PUPP(volk_32fc_s32f_ncopuppet_32fc, volk_32fc_s32f_nco_32fc, test_params))
         // no one uses these, so don't test them
         //VOLK_PROFILE(volk_16i_x5_add_quad_16i_x4, 1e-4, 2046, 10000, &results, benchmark_mode, kernel_regex);
         //VOLK_PROFILE(volk_16i_branch_4_state_8, 1e-4, 2046, 10000, &results, benchmark_mode, kernel_regex);
@@ -145,6 +151,10 @@ std::vector<volk_test_case_t> init_test_list(volk_test_params_t test_params)
 
         ;
 
+    // entries with their own params still take the run wide settings
+    for(size_t i = 0; i < test_cases.size(); i++) {
+        test_cases[i].set_test_parameters(test_cases[i].test_parameters().make_run(test_params));
+    }
 
     return test_cases;
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Builds the generated cpu probe against a canned CPU profile instead of
+ * the cpuid and xgetbv instructions of the host.
+ */
+
+#include "qa_cpu_stub.h"
+
+#define VOLK_CPU_STUB
+#include "volk_cpu.c"
+
+volk_cpu_stub_profile_t volk_cpu_stub_profile;
+unsigned int volk_cpu_stub_ncalls = 0;
+
+void volk_cpu_stub_cpuid(unsigned int op, unsigned int count, unsigned int *regs)
+{
+    volk_cpu_stub_ncalls++;
+    memset(regs, 0, sizeof(unsigned int)*4);
+    switch(op) {
+    case 0x00000001:
+        regs[2] = volk_cpu_stub_profile.leaf1_ecx;
+        regs[3] = volk_cpu_stub_profile.leaf1_edx;
+        break;
+    case 0x00000007:
+        if(count == 0) regs[1] = volk_cpu_stub_profile.leaf7_ebx;
+        break;
+    case 0x80000000:
+        regs[0] = 0x80000001;
+        break;
+    case 0x80000001:
+        regs[2] = volk_cpu_stub_profile.ext1_ecx;
+        regs[3] = volk_cpu_stub_profile.ext1_edx;
+        break;
+    }
+}
+
+unsigned long long volk_cpu_stub_xgetbv(void)
+{
+    return volk_cpu_stub_profile.xcr0;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_QA_CPU_STUB_H
+#define INCLUDED_VOLK_QA_CPU_STUB_H
+
+#include <volk/volk_common.h>
+
+__VOLK_DECL_BEGIN
+
+/*
+ * The cpuid/xgetbv answers seen by a volk_cpu.c built with VOLK_CPU_STUB.
+ * Only the registers volk's arch checks look at are modelled; every other
+ * leaf and register reads as zero.
+ */
+typedef struct
+{
+    unsigned int leaf1_ecx; //cpuid(1).ecx: sse3 ... avx, osxsave
+    unsigned int leaf1_edx; //cpuid(1).edx: mmx, sse, sse2
+    unsigned int leaf7_ebx; //cpuid(7,0).ebx: avx2, avx512f
+    unsigned int ext1_ecx;  //cpuid(0x80000001).ecx: sse4_a
+    unsigned int ext1_edx;  //cpuid(0x80000001).edx: long mode
+    unsigned long long xcr0;
+} volk_cpu_stub_profile_t;
+
+extern volk_cpu_stub_profile_t volk_cpu_stub_profile;
+
+//number of cpuid instructions issued so far
+extern unsigned int volk_cpu_stub_ncalls;
+
+__VOLK_DECL_END
+
+#endif /*INCLUDED_VOLK_QA_CPU_STUB_H*/
@@ -12,15 +12,29 @@
 #include <vector>
 #include <map>
 #include <list>
-#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <limits>
+#include <random>
 
 #include <volk/volk.h>
 #include <volk/volk_cpu.h>
 #include <volk/volk_common.h>
 #include <volk/volk_malloc.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#endif
+
 float uniform() {
   return 2.0f * ((float) rand() / RAND_MAX - 0.5f);	// uniformly (-1, 1)
 }
@@ -77,6 +91,41 @@ static std::vector<std::string> get_arch_list(volk_func_desc_t desc) {
     return archlist;
 }
 
+static const char *residency_names[] = {"hot", "l1", "l2", "llc", "dram"};
+
+std::string volk_residency_name(volk_residency_t residency) {
+    return residency_names[residency];
+}
+
+bool volk_residency_from_name(const std::string &name, volk_residency_t *residency) {
+    for(int i = VOLK_RESIDENCY_HOT; i <= VOLK_RESIDENCY_DRAM; i++) {
+        if(name == residency_names[i]) {
+            *residency = (volk_residency_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+//the data cache sizes as the OS reports them, with typical sizes otherwise
+size_t volk_residency_bytes(volk_residency_t residency) {
+    long l1 = 0, l2 = 0, l3 = 0;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+    if(l1 <= 0) l1 = 32 << 10;
+    if(l2 <= 0) l2 = 256 << 10;
+    if(l3 <= 0) l3 = std::max(l2, 8L << 20);
+    switch(residency) {
+        case VOLK_RESIDENCY_L1: return (size_t)l1;
+        case VOLK_RESIDENCY_L2: return (size_t)l2;
+        case VOLK_RESIDENCY_LLC: return (size_t)l3;
+        default: return 0;
+    }
+}
+
 volk_type_t volk_type_from_string(std::string name) {
     volk_type_t type;
     type.is_float = false;
@@ -220,7 +269,7 @@ inline void run_cast_test3_s32fc(volk_fn_3arg_s32fc func, std::vector<void *> &b
 }
 
 template <class t>
-bool fcompare(t *in1, t *in2, unsigned int vlen, float tol) {
+bool fcompare(t *in1, t *in2, unsigned int vlen, float tol, std::ostream &out) {
     bool fail = false;
     int print_max_errs = 10;
     for(unsigned int i=0; i<vlen; i++) {
@@ -231,8 +280,8 @@ bool fcompare(t *in1, t *in2, unsigned int vlen, float tol) {
             {
                 fail=true;
                 if(print_max_errs-- > 0) {
-                    std::cout << "offset " << i << " in1: " << t(((t *)(in1))[i]) << " in2: " << t(((t *)(in2))[i]);
-                    std::cout << " tolerance was: " << tol << std::endl;
+                    out << "offset " << i << " in1: " << t(((t *)(in1))[i]) << " in2: " << t(((t *)(in2))[i]);
+                    out << " tolerance was: " << tol << std::endl;
                 }
             }
         }
@@ -240,8 +289,8 @@ bool fcompare(t *in1, t *in2, unsigned int vlen, float tol) {
         else if(fabs(((t *)(in1))[i] - ((t *)(in2))[i])/fabs(((t *)in1)[i]) > tol) {
             fail=true;
             if(print_max_errs-- > 0) {
-                std::cout << "offset " << i << " in1: " << t(((t *)(in1))[i]) << " in2: " << t(((t *)(in2))[i]);
-                std::cout << " tolerance was: " << tol << std::endl;
+                out << "offset " << i << " in1: " << t(((t *)(in1))[i]) << " in2: " << t(((t *)(in2))[i]);
+                out << " tolerance was: " << tol << std::endl;
             }
         }
     }
@@ -250,7 +299,7 @@ bool fcompare(t *in1, t *in2, unsigned int vlen, float tol) {
 }
 
 template <class t>
-bool ccompare(t *in1, t *in2, unsigned int vlen, float tol) {
+bool ccompare(t *in1, t *in2, unsigned int vlen, float tol, std::ostream &out) {
     bool fail = false;
     int print_max_errs = 10;
     for(unsigned int i=0; i<2*vlen; i+=2) {
@@ -265,8 +314,8 @@ bool ccompare(t *in1, t *in2, unsigned int vlen, float tol) {
             {
                 fail=true;
                 if(print_max_errs-- > 0) {
-                    std::cout << "offset " << i/2 << " in1: " << in1[i] << " + " << in1[i+1] << "j  in2: " << in2[i] << " + " << in2[i+1] << "j";
-                    std::cout << " tolerance was: " << tol << std::endl;
+                    out << "offset " << i/2 << " in1: " << in1[i] << " + " << in1[i+1] << "j  in2: " << in2[i] << " + " << in2[i+1] << "j";
+                    out << " tolerance was: " << tol << std::endl;
                 }
             }
         }
@@ -274,8 +323,8 @@ bool ccompare(t *in1, t *in2, unsigned int vlen, float tol) {
         else if((err / norm) > tol) {
             fail=true;
             if(print_max_errs-- > 0) {
-                std::cout << "offset " << i/2 << " in1: " << in1[i] << " + " << in1[i+1] << "j  in2: " << in2[i] << " + " << in2[i+1] << "j";
-                std::cout << " tolerance was: " << tol << std::endl;
+                out << "offset " << i/2 << " in1: " << in1[i] << " + " << in1[i+1] << "j  in2: " << in2[i] << " + " << in2[i+1] << "j";
+                out << " tolerance was: " << tol << std::endl;
             }
         }
     }
@@ -284,15 +333,15 @@ bool ccompare(t *in1, t *in2, unsigned int vlen, float tol) {
 }
 
 template <class t>
-bool icompare(t *in1, t *in2, unsigned int vlen, unsigned int tol) {
+bool icompare(t *in1, t *in2, unsigned int vlen, unsigned int tol, std::ostream &out) {
     bool fail = false;
     int print_max_errs = 10;
     for(unsigned int i=0; i<vlen; i++) {
       if(((unsigned int)abs(int(((t *)(in1))[i]) - int(((t *)(in2))[i]))) > tol) {
             fail=true;
             if(print_max_errs-- > 0) {
-                std::cout << "offset " << i << " in1: " << static_cast<int>(t(((t *)(in1))[i])) << " in2: " << static_cast<int>(t(((t *)(in2))[i]));
-                std::cout << " tolerance was: " << tol << std::endl;
+                out << "offset " << i << " in1: " << static_cast<int>(t(((t *)(in1))[i])) << " in2: " << static_cast<int>(t(((t *)(in2))[i]));
+                out << " tolerance was: " << tol << std::endl;
             }
         }
     }
@@ -300,6 +349,179 @@ bool icompare(t *in1, t *in2, unsigned int vlen, unsigned int tol) {
     return fail;
 }
 
+// calls the arch implementation iter times, unpacking the scalar inputs
+static void run_arch(void (*manual_func)(), std::vector<void *> &buffs, size_t n_sigs,
+                     const std::vector<volk_type_t> &inputsc, lv_32fc_t scalar,
+                     unsigned int vlen, unsigned int iter, const std::string &arch)
+{
+    switch(n_sigs) {
+        case 1:
+            if(inputsc.size() == 0) {
+                run_cast_test1((volk_fn_1arg)(manual_func), buffs, vlen, iter, arch);
+            } else if(inputsc.size() == 1 && inputsc[0].is_float) {
+                if(inputsc[0].is_complex) {
+                    run_cast_test1_s32fc((volk_fn_1arg_s32fc)(manual_func), buffs, scalar, vlen, iter, arch);
+                } else {
+                    run_cast_test1_s32f((volk_fn_1arg_s32f)(manual_func), buffs, scalar.real(), vlen, iter, arch);
+                }
+            } else throw "unsupported 1 arg function >1 scalars";
+            break;
+        case 2:
+            if(inputsc.size() == 0) {
+                run_cast_test2((volk_fn_2arg)(manual_func), buffs, vlen, iter, arch);
+            } else if(inputsc.size() == 1 && inputsc[0].is_float) {
+                if(inputsc[0].is_complex) {
+                    run_cast_test2_s32fc((volk_fn_2arg_s32fc)(manual_func), buffs, scalar, vlen, iter, arch);
+                } else {
+                    run_cast_test2_s32f((volk_fn_2arg_s32f)(manual_func), buffs, scalar.real(), vlen, iter, arch);
+                }
+            } else throw "unsupported 2 arg function >1 scalars";
+            break;
+        case 3:
+            if(inputsc.size() == 0) {
+                run_cast_test3((volk_fn_3arg)(manual_func), buffs, vlen, iter, arch);
+            } else if(inputsc.size() == 1 && inputsc[0].is_float) {
+                if(inputsc[0].is_complex) {
+                    run_cast_test3_s32fc((volk_fn_3arg_s32fc)(manual_func), buffs, scalar, vlen, iter, arch);
+                } else {
+                    run_cast_test3_s32f((volk_fn_3arg_s32f)(manual_func), buffs, scalar.real(), vlen, iter, arch);
+                }
+            } else throw "unsupported 3 arg function >1 scalars";
+            break;
+        case 4:
+            run_cast_test4((volk_fn_4arg)(manual_func), buffs, vlen, iter, arch);
+            break;
+        default:
+            throw "no function handler for this signature";
+            break;
+    }
+}
+
+// linear interpolation between the closest ranks of sorted samples
+static double percentile(const std::vector<double> &sorted, double pct)
+{
+    if(sorted.empty()) return 0.0;
+    const double rank = pct / 100.0 * (sorted.size() - 1);
+    const size_t lo = (size_t)std::floor(rank);
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+static volk_test_stats_t make_stats(unsigned int vlen, unsigned int iter, volk_residency_t residency,
+                                    size_t point_bytes, size_t working_set, const std::vector<double> &trials)
+{
+    volk_test_stats_t stats;
+    std::vector<double> sorted(trials);
+    std::sort(sorted.begin(), sorted.end());
+    stats.vlen = vlen;
+    stats.iter = iter;
+    stats.residency = residency;
+    stats.working_set = working_set;
+    stats.trials = trials;
+    stats.median = percentile(sorted, 50);
+    stats.p10 = percentile(sorted, 10);
+    stats.p90 = percentile(sorted, 90);
+    stats.ns_per_point = (iter && vlen)? stats.median / ((double)iter * vlen) : 0.0;
+    stats.gbps = (stats.median > 0)? (double)point_bytes * vlen * iter / stats.median : 0.0;
+    return stats;
+}
+
+/*
+ * Hardware counters for the timed trials, read through perf_event_open.
+ * Events the kernel or the CPU refuse are left out, and without any the
+ * trials are only timed. Counters follow the thread that opened them.
+ */
+class volk_qa_perf_counters{
+public:
+    volk_qa_perf_counters(bool enable) {
+#if defined(__linux__)
+        if(!enable) return;
+        add("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        if(_fds.empty()) {
+            warn(errno);
+            return;
+        }
+        add("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        add("l1d_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        add("llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        //cycles spent in each frequency license (CORE_POWER.LVL*_TURBO_LICENSE),
+        //only meaningful on Intel cores from Skylake-SP on
+        if(is_intel()) {
+            add("avx_license_0_cycles", PERF_TYPE_RAW, 0x0728);
+            add("avx_license_1_cycles", PERF_TYPE_RAW, 0x1828);
+            add("avx_license_2_cycles", PERF_TYPE_RAW, 0x2028);
+        }
+#else
+        (void)enable;
+#endif
+    }
+    ~volk_qa_perf_counters() {
+#if defined(__linux__)
+        for(size_t i = 0; i < _fds.size(); i++) close(_fds[i]);
+#endif
+    }
+    bool active() const { return !_fds.empty(); }
+    const std::vector<std::string> &names() const { return _names; }
+    void start() {
+#if defined(__linux__)
+        for(size_t i = 0; i < _fds.size(); i++) {
+            ioctl(_fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    // adds the counts since start() to sums, scaled up if the kernel
+    // had to multiplex the counters
+    void stop(std::vector<double> &sums) {
+        sums.resize(_fds.size(), 0.0);
+#if defined(__linux__)
+        for(size_t i = 0; i < _fds.size(); i++) ioctl(_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        for(size_t i = 0; i < _fds.size(); i++) {
+            uint64_t value[3] = {0, 0, 0}; //count, time enabled, time running
+            if(read(_fds[i], value, sizeof(value)) != sizeof(value) || value[2] == 0) continue;
+            sums[i] += (double)value[0] * ((double)value[1] / (double)value[2]);
+        }
+#endif
+    }
+private:
+#if defined(__linux__)
+    void add(const char *name, uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        const int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if(fd < 0) return;
+        _fds.push_back(fd);
+        _names.push_back(name);
+    }
+    static bool is_intel() {
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while(std::getline(cpuinfo, line)) {
+            if(line.compare(0, 9, "vendor_id") == 0) return line.find("GenuineIntel") != std::string::npos;
+        }
+        return false;
+    }
+    static void warn(int error) {
+        static std::atomic<bool> warned(false);
+        if(warned.exchange(true)) return;
+        std::cerr << "Hardware counters unavailable: " << strerror(error);
+        if(error == EACCES || error == EPERM)
+            std::cerr << " (see /proc/sys/kernel/perf_event_paranoid)";
+        std::cerr << std::endl;
+    }
+#endif
+    std::vector<int> _fds;
+    std::vector<std::string> _names;
+};
+
 class volk_qa_aligned_mem_pool{
 public:
     void *get_new(size_t size){
@@ -322,12 +544,14 @@ bool run_volk_tests(volk_func_desc_t desc,
                     std::string name,
                     volk_test_params_t test_params,
                     std::vector<volk_test_results_t> *results,
-                    std::string puppet_master_name
+                    std::string puppet_master_name,
+                    std::ostream &out
 )
 {
     return run_volk_tests(desc, manual_func, name, test_params.tol(), test_params.scalar(),
         test_params.vlen(), test_params.iter(), results, puppet_master_name,
-        test_params.benchmark_mode());
+        test_params.benchmark_mode(), test_params.trials(), test_params.bench_vlens(),
+        test_params.residencies(), test_params.counters(), out);
 }
 
 bool run_volk_tests(volk_func_desc_t desc,
@@ -339,20 +563,26 @@ bool run_volk_tests(volk_func_desc_t desc,
                     unsigned int iter,
                     std::vector<volk_test_results_t> *results,
                     std::string puppet_master_name,
-                    bool benchmark_mode
+                    bool benchmark_mode,
+                    unsigned int trials,
+                    std::vector<unsigned int> bench_vlens,
+                    std::vector<volk_residency_t> residencies,
+                    bool counters,
+                    std::ostream &out
 ) {
     // Initialize this entry in results vector
     results->push_back(volk_test_results_t());
     results->back().name = name;
     results->back().vlen = vlen;
     results->back().iter = iter;
-    std::cout << "RUN_VOLK_TESTS: " << name << "(" << vlen << "," << iter << ")" << std::endl;
+    out << "RUN_VOLK_TESTS: " << name << "(" << vlen << "," << iter << ")" << std::endl;
 
     // vlen_twiddle will increase vlen for malloc and data generation
     // but kernels will still be called with the user provided vlen.
     // This is useful for causing errors in kernels that do bad reads
     const unsigned int vlen_twiddle = 5;
-    vlen = vlen + vlen_twiddle;
+
+    const unsigned int test_vlen = vlen;
 
     const float tol_f = tol;
     const unsigned int tol_i = static_cast<const unsigned int>(tol);
@@ -361,7 +591,7 @@ bool run_volk_tests(volk_func_desc_t desc,
     std::vector<std::string> arch_list = get_arch_list(desc);
 
     if((!benchmark_mode) && (arch_list.size() < 2)) {
-        std::cout << "no architectures to test" << std::endl;
+        out << "no architectures to test" << std::endl;
         return false;
     }
 
@@ -388,6 +618,38 @@ bool run_volk_tests(volk_func_desc_t desc,
             i -= 1;
         }
     }
+    std::vector<volk_type_t> both_sigs;
+    both_sigs.insert(both_sigs.end(), outputsig.begin(), outputsig.end());
+    both_sigs.insert(both_sigs.end(), inputsig.begin(), inputsig.end());
+
+    //bytes each point moves through the kernel's inputs and outputs
+    size_t point_bytes = 0;
+    for(size_t j = 0; j < both_sigs.size(); j++) {
+        point_bytes += both_sigs[j].size * (both_sigs[j].is_complex ? 2 : 1);
+    }
+
+    //the timed runs, the hot test vlen first; a cache level gets the length
+    //whose working set fills half of it, DRAM runs the test vlen on a ring
+    std::vector<std::pair<unsigned int, volk_residency_t> > timed;
+    timed.push_back(std::make_pair(test_vlen, VOLK_RESIDENCY_HOT));
+    for(size_t i = 0; i < bench_vlens.size(); i++) {
+        if(bench_vlens[i] > 0 && bench_vlens[i] != test_vlen)
+            timed.push_back(std::make_pair(bench_vlens[i], VOLK_RESIDENCY_HOT));
+    }
+    for(size_t i = 0; i < residencies.size(); i++) {
+        unsigned int len = test_vlen;
+        if(residencies[i] == VOLK_RESIDENCY_HOT) continue;
+        if(residencies[i] != VOLK_RESIDENCY_DRAM && point_bytes > 0) {
+            len = (unsigned int)std::max<size_t>(1, volk_residency_bytes(residencies[i]) / 2 / point_bytes);
+        }
+        timed.push_back(std::make_pair(len, residencies[i]));
+    }
+
+    //buffers must hold the longest timed length
+    vlen = test_vlen;
+    for(size_t l = 0; l < timed.size(); l++) vlen = std::max(vlen, timed[l].first);
+    vlen = vlen + vlen_twiddle;
+
     std::vector<void *> inbuffs;
     BOOST_FOREACH(volk_type_t sig, inputsig) {
         if(!sig.is_scalar) //we don't make buffers for scalars
@@ -412,67 +674,110 @@ bool run_volk_tests(volk_func_desc_t desc,
         test_data.push_back(arch_buffs);
     }
 
-    std::vector<volk_type_t> both_sigs;
-    both_sigs.insert(both_sigs.end(), outputsig.begin(), outputsig.end());
-    both_sigs.insert(both_sigs.end(), inputsig.begin(), inputsig.end());
+    //the DRAM ring: enough copies of every buffer to outgrow the LLC four
+    //times over (capped at 1GiB), shared by all archs since only their
+    //timing is kept
+    std::vector<std::vector<void *> > ring;
+    if(std::find(residencies.begin(), residencies.end(), VOLK_RESIDENCY_DRAM) != residencies.end()) {
+        const size_t alignment = volk_get_alignment();
+        const size_t set_bytes = std::max<size_t>(1, point_bytes * test_vlen);
+        const size_t ring_bytes = std::min<size_t>(4 * volk_residency_bytes(VOLK_RESIDENCY_LLC), (size_t)1 << 30);
+        const size_t n_sets = std::max<size_t>(2, (ring_bytes + set_bytes - 1) / set_bytes);
+        ring.resize(n_sets);
+        for(size_t j = 0; j < both_sigs.size(); j++) {
+            const size_t bytes = (size_t)test_vlen * both_sigs[j].size * (both_sigs[j].is_complex ? 2 : 1);
+            const size_t stride = (bytes + alignment - 1) / alignment * alignment;
+            char *slab = (char *)mem_pool.get_new(stride * n_sets);
+            for(size_t k = 0; k < n_sets; k++) {
+                //inputs start out as the test data so no kernel sees garbage
+                if(j >= outputsig.size()) memcpy(slab + k * stride, inbuffs[j - outputsig.size()], bytes);
+                ring[k].push_back(slab + k * stride);
+            }
+        }
+    }
 
     //now run the test
-    vlen = vlen - vlen_twiddle;
-    clock_t start, end;
-    std::vector<double> profile_times;
-    for(size_t i = 0; i < arch_list.size(); i++) {
-        start = clock();
+    vlen = test_vlen;
+    if(trials == 0) trials = 1;
+    static thread_local std::mt19937 arch_order_rng(std::random_device{}());
+    std::vector<size_t> arch_order(arch_list.size());
+    for(size_t i = 0; i < arch_list.size(); i++) arch_order[i] = i;
+    std::vector<std::vector<volk_test_stats_t> > arch_stats(arch_list.size());
+    volk_qa_perf_counters perf(counters);
+
+    for(size_t l = 0; l < timed.size(); l++) {
+        //other lengths move as much data per trial as the test vlen does
+        const unsigned int len = timed[l].first;
+        const volk_residency_t residency = timed[l].second;
+        const unsigned int len_iter = (len == vlen || iter == 0)? iter :
+            (unsigned int)std::max(1.0, std::ceil((double)iter * vlen / len));
+        const size_t working_set = point_bytes * len * (residency == VOLK_RESIDENCY_DRAM ? ring.size() : 1);
+        size_t ring_slot = 0;
+        std::vector<std::vector<double> > samples(arch_list.size());
+        std::vector<std::vector<double> > counts(arch_list.size());
+
+        //an untimed pass first, so no arch pays for cold caches or a
+        //clock still ramping up; a test asking for no iterations gets none
+        for(size_t i = 0; i < arch_list.size(); i++) {
+            run_arch(manual_func, test_data[i], both_sigs.size(), inputsc, scalar,
+                     len, len_iter? std::max(1u, len_iter / 10) : 0, arch_list[i]);
+        }
 
-        switch(both_sigs.size()) {
-            case 1:
-                if(inputsc.size() == 0) {
-                    run_cast_test1((volk_fn_1arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                } else if(inputsc.size() == 1 && inputsc[0].is_float) {
-                    if(inputsc[0].is_complex) {
-                        run_cast_test1_s32fc((volk_fn_1arg_s32fc)(manual_func), test_data[i], scalar, vlen, iter, arch_list[i]);
-                    } else {
-                        run_cast_test1_s32f((volk_fn_1arg_s32f)(manual_func), test_data[i], scalar.real(), vlen, iter, arch_list[i]);
-                    }
-                } else throw "unsupported 1 arg function >1 scalars";
-                break;
-            case 2:
-                if(inputsc.size() == 0) {
-                    run_cast_test2((volk_fn_2arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                } else if(inputsc.size() == 1 && inputsc[0].is_float) {
-                    if(inputsc[0].is_complex) {
-                        run_cast_test2_s32fc((volk_fn_2arg_s32fc)(manual_func), test_data[i], scalar, vlen, iter, arch_list[i]);
-                    } else {
-                        run_cast_test2_s32f((volk_fn_2arg_s32f)(manual_func), test_data[i], scalar.real(), vlen, iter, arch_list[i]);
-                    }
-                } else throw "unsupported 2 arg function >1 scalars";
-                break;
-            case 3:
-                if(inputsc.size() == 0) {
-                    run_cast_test3((volk_fn_3arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                } else if(inputsc.size() == 1 && inputsc[0].is_float) {
-                    if(inputsc[0].is_complex) {
-                        run_cast_test3_s32fc((volk_fn_3arg_s32fc)(manual_func), test_data[i], scalar, vlen, iter, arch_list[i]);
-                    } else {
-                        run_cast_test3_s32f((volk_fn_3arg_s32f)(manual_func), test_data[i], scalar.real(), vlen, iter, arch_list[i]);
+        //a fresh arch order per trial keeps drift from favouring any one arch
+        for(unsigned int t = 0; t < trials; t++) {
+            std::shuffle(arch_order.begin(), arch_order.end(), arch_order_rng);
+            for(size_t o = 0; o < arch_order.size(); o++) {
+                const size_t i = arch_order[o];
+                if(perf.active()) perf.start();
+                const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                if(residency == VOLK_RESIDENCY_DRAM) {
+                    for(unsigned int k = 0; k < len_iter; k++) {
+                        run_arch(manual_func, ring[ring_slot], both_sigs.size(), inputsc, scalar,
+                                 len, 1, arch_list[i]);
+                        ring_slot = (ring_slot + 1) % ring.size();
                     }
-                } else throw "unsupported 3 arg function >1 scalars";
-                break;
-            case 4:
-                run_cast_test4((volk_fn_4arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
-                break;
-            default:
-                throw "no function handler for this signature";
-                break;
+                }
+                else {
+                    run_arch(manual_func, test_data[i], both_sigs.size(), inputsc, scalar,
+                             len, len_iter, arch_list[i]);
+                }
+                const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+                if(perf.active()) perf.stop(counts[i]);
+                samples[i].push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
         }
 
-        end = clock();
-        double arch_time = 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
-        std::cout << arch_list[i] << " completed in " << arch_time << "ms" << std::endl;
+        for(size_t i = 0; i < arch_list.size(); i++) {
+            arch_stats[i].push_back(make_stats(len, len_iter, residency, point_bytes, working_set, samples[i]));
+            for(size_t c = 0; c < counts[i].size(); c++) {
+                arch_stats[i].back().counters[perf.names()[c]] = counts[i][c] / trials;
+            }
+        }
+    }
+
+    std::vector<double> profile_times;
+    for(size_t i = 0; i < arch_list.size(); i++) {
+        const volk_test_stats_t &stats = arch_stats[i][0];
+        double arch_time = stats.median / 1e6;
+        out << arch_list[i] << " completed in " << arch_time << "ms";
+        if(trials > 1) {
+            out << " (p10 " << stats.p10 / 1e6 << "ms, p90 " << stats.p90 / 1e6
+                      << "ms, " << stats.ns_per_point << "ns/point, " << stats.gbps << "GB/s)";
+        }
+        out << std::endl;
+        for(size_t l = 1; l < arch_stats[i].size(); l++) {
+            const volk_test_stats_t &other = arch_stats[i][l];
+            if(other.residency == VOLK_RESIDENCY_HOT) continue;
+            out << "  " << volk_residency_name(other.residency) << " (" << other.vlen << " points, "
+                      << other.working_set << " bytes): " << other.ns_per_point << "ns/point, "
+                      << other.gbps << "GB/s" << std::endl;
+        }
         volk_test_time_t result;
         result.name = arch_list[i];
         result.time = arch_time;
         result.units = "ms";
         result.pass = true;
+        result.stats = arch_stats[i];
         results->back().results[result.name] = result;
 
         profile_times.push_back(arch_time);
@@ -499,15 +804,15 @@ bool run_volk_tests(volk_func_desc_t desc,
                 if(both_sigs[j].is_float) {
                     if(both_sigs[j].size == 8) {
                         if (both_sigs[j].is_complex) {
-                            fail = ccompare((double *) test_data[generic_offset][j], (double *) test_data[i][j], vlen, tol_f);
+                            fail = ccompare((double *) test_data[generic_offset][j], (double *) test_data[i][j], vlen, tol_f, out);
                         } else {
-                            fail = fcompare((double *) test_data[generic_offset][j], (double *) test_data[i][j], vlen, tol_f);
+                            fail = fcompare((double *) test_data[generic_offset][j], (double *) test_data[i][j], vlen, tol_f, out);
                         }
                     } else {
                         if (both_sigs[j].is_complex) {
-                            fail = ccompare((float *) test_data[generic_offset][j], (float *) test_data[i][j], vlen, tol_f);
+                            fail = ccompare((float *) test_data[generic_offset][j], (float *) test_data[i][j], vlen, tol_f, out);
                         } else {
-                            fail = fcompare((float *) test_data[generic_offset][j], (float *) test_data[i][j], vlen, tol_f);
+                            fail = fcompare((float *) test_data[generic_offset][j], (float *) test_data[i][j], vlen, tol_f, out);
                         }
                     }
                 } else {
@@ -515,41 +820,41 @@ bool run_volk_tests(volk_func_desc_t desc,
                     switch(both_sigs[j].size) {
                     case 8:
                         if(both_sigs[j].is_signed) {
-                            fail = icompare((int64_t *) test_data[generic_offset][j], (int64_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                            fail = icompare((int64_t *) test_data[generic_offset][j], (int64_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                         } else {
-                            fail = icompare((uint64_t *) test_data[generic_offset][j], (uint64_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                            fail = icompare((uint64_t *) test_data[generic_offset][j], (uint64_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                         }
                         break;
                     case 4:
                         if(both_sigs[j].is_complex) {
                             if(both_sigs[j].is_signed) {
-                                fail = icompare((int16_t *) test_data[generic_offset][j], (int16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                                fail = icompare((int16_t *) test_data[generic_offset][j], (int16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                             } else {
-                                fail = icompare((uint16_t *) test_data[generic_offset][j], (uint16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                                fail = icompare((uint16_t *) test_data[generic_offset][j], (uint16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                             }
                         }
                         else {
                             if (both_sigs[j].is_signed) {
                                 fail = icompare((int32_t *) test_data[generic_offset][j], (int32_t *) test_data[i][j],
-                                                vlen * (both_sigs[j].is_complex ? 2 : 1), tol_i);
+                                                vlen * (both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                             } else {
                                 fail = icompare((uint32_t *) test_data[generic_offset][j], (uint32_t *) test_data[i][j],
-                                                vlen * (both_sigs[j].is_complex ? 2 : 1), tol_i);
+                                                vlen * (both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                             }
                         }
                         break;
                     case 2:
                         if(both_sigs[j].is_signed) {
-                            fail = icompare((int16_t *) test_data[generic_offset][j], (int16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                            fail = icompare((int16_t *) test_data[generic_offset][j], (int16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                         } else {
-                            fail = icompare((uint16_t *) test_data[generic_offset][j], (uint16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                            fail = icompare((uint16_t *) test_data[generic_offset][j], (uint16_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                         }
                         break;
                     case 1:
                         if(both_sigs[j].is_signed) {
-                            fail = icompare((int8_t *) test_data[generic_offset][j], (int8_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                            fail = icompare((int8_t *) test_data[generic_offset][j], (int8_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                         } else {
-                            fail = icompare((uint8_t *) test_data[generic_offset][j], (uint8_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i);
+                            fail = icompare((uint8_t *) test_data[generic_offset][j], (uint8_t *) test_data[i][j], vlen*(both_sigs[j].is_complex ? 2 : 1), tol_i, out);
                         }
                         break;
                     default:
@@ -560,7 +865,7 @@ bool run_volk_tests(volk_func_desc_t desc,
                     volk_test_time_t *result = &results->back().results[arch_list[i]];
                     result->pass = !fail;
                     fail_global = true;
-                    std::cout << name << ": fail on arch " << arch_list[i] << std::endl;
+                    out << name << ": fail on arch " << arch_list[i] << std::endl;
                 }
             }
         }
@@ -585,8 +890,8 @@ bool run_volk_tests(volk_func_desc_t desc,
         }
     }
 
-    std::cout << "Best aligned arch: " << best_arch_a << std::endl;
-    std::cout << "Best unaligned arch: " << best_arch_u << std::endl;
+    out << "Best aligned arch: " << best_arch_a << std::endl;
+    out << "Best unaligned arch: " << best_arch_u << std::endl;
 
     if(puppet_master_name == "NULL") {
         results->back().config_name = name;
@@ -22,12 +22,47 @@ struct volk_type_t {
     std::string str;
 };
 
+// where the timed buffers live: reused in place (hot), sized to stay in
+// one cache level, or rotated through a ring several times the LLC
+enum volk_residency_t {
+    VOLK_RESIDENCY_HOT,
+    VOLK_RESIDENCY_L1,
+    VOLK_RESIDENCY_L2,
+    VOLK_RESIDENCY_LLC,
+    VOLK_RESIDENCY_DRAM
+};
+
+// timing distribution of one arch at one vector length
+class volk_test_stats_t {
+    public:
+        unsigned int vlen;
+        unsigned int iter;          // kernel calls per trial
+        volk_residency_t residency;
+        size_t working_set;         // bytes a trial cycles through
+        std::vector<double> trials; // ns per trial, in the order they ran
+        double median;              // ns per trial
+        double p10;
+        double p90;
+        double ns_per_point;        // median / (iter * vlen)
+        double gbps;                // bytes read and written per ns
+        std::map<std::string, double> counters; // hardware counts per trial
+};
+
 class volk_test_time_t {
     public:
         std::string name;
-        double time;
+        double time;  // median trial at the test vlen
         std::string units;
         bool pass;
+        std::vector<volk_test_stats_t> stats; // the test vlen first
+};
+
+// best archs for vector lengths below max_len; see volk_arch_pref_ex_t
+class volk_test_bucket_t {
+    public:
+        unsigned int max_len;
+        std::string best_arch_a;
+        std::string best_arch_u;
 };
 
 class volk_test_results_t {
@@ -39,6 +74,7 @@ class volk_test_results_t {
         std::map<std::string, volk_test_time_t> results;
         std::string best_arch_a;
         std::string best_arch_u;
+        std::vector<volk_test_bucket_t> buckets;
 };
 
 class volk_test_params_t {
@@ -49,12 +85,37 @@ class volk_test_params_t {
         unsigned int _iter;
         bool _benchmark_mode;
         std::string _kernel_regex;
+        unsigned int _trials;
+        std::vector<unsigned int> _bench_vlens;
+        std::vector<volk_residency_t> _residencies;
+        bool _counters;
     public:
         // ctor
         volk_test_params_t(float tol, lv_32fc_t scalar, unsigned int vlen, unsigned int iter,
-                           bool benchmark_mode, std::string kernel_regex) :
+                           bool benchmark_mode, std::string kernel_regex,
+                           unsigned int trials = 1,
+                           std::vector<unsigned int> bench_vlens = std::vector<unsigned int>(),
+                           std::vector<volk_residency_t> residencies = std::vector<volk_residency_t>(),
+                           bool counters = false) :
             _tol(tol), _scalar(scalar), _vlen(vlen), _iter(iter),
-            _benchmark_mode(benchmark_mode), _kernel_regex(kernel_regex) {};
+            _benchmark_mode(benchmark_mode), _kernel_regex(kernel_regex),
+            _trials(trials), _bench_vlens(bench_vlens), _residencies(residencies),
+            _counters(counters) {};
+        // copy with the tolerance changed
+        volk_test_params_t make_tol(float tol) {
+            volk_test_params_t params(*this);
+            params._tol = tol;
+            return params;
+        };
+        // copy with the trials, lengths, residencies and counters of run
+        volk_test_params_t make_run(volk_test_params_t run) {
+            volk_test_params_t params(*this);
+            params._trials = run._trials;
+            params._bench_vlens = run._bench_vlens;
+            params._residencies = run._residencies;
+            params._counters = run._counters;
+            return params;
+        };
         // getters
         float tol() {return _tol;};
         lv_32fc_t scalar() {return _scalar;};
@@ -62,6 +123,14 @@ class volk_test_params_t {
         unsigned int iter() {return _iter;};
         bool benchmark_mode() {return _benchmark_mode;};
         std::string kernel_regex() {return _kernel_regex;};
+        // timed trials per arch and vector length
+        unsigned int trials() {return _trials;};
+        // further vector lengths to time, besides vlen
+        std::vector<unsigned int> bench_vlens() {return _bench_vlens;};
+        // cache levels to time in besides the hot runs
+        std::vector<volk_residency_t> residencies() {return _residencies;};
+        // read hardware counters during the trials, where permitted
+        bool counters() {return _counters;};
 };
 
 class volk_test_case_t {
@@ -77,6 +146,7 @@ class volk_test_case_t {
         std::string name() {return _name;};
         std::string puppet_master_name() {return _puppet_master_name;};
         volk_test_params_t test_parameters() {return _test_parameters;};
+        void set_test_parameters(volk_test_params_t test_parameters) {_test_parameters = test_parameters;};
         // normal ctor
         volk_test_case_t(volk_func_desc_t desc, void(*kernel_ptr)(), std::string name,
             volk_test_params_t test_parameters) :
@@ -96,6 +166,10 @@ class volk_test_case_t {
  ************************************************/
 volk_type_t volk_type_from_string(std::string);
 
+std::string volk_residency_name(volk_residency_t);
+bool volk_residency_from_name(const std::string &, volk_residency_t *);
+size_t volk_residency_bytes(volk_residency_t); // cache size, 0 for hot and DRAM
+
 float uniform(void);
 void random_floats(float *buf, unsigned n);
 
@@ -105,7 +179,8 @@ bool run_volk_tests(
     std::string,
     volk_test_params_t,
     std::vector<volk_test_results_t> *results = NULL,
-    std::string puppet_master_name = "NULL"
+    std::string puppet_master_name = "NULL",
+    std::ostream &out = std::cout
     );
 
 bool run_volk_tests(
@@ -118,7 +193,12 @@ bool run_volk_tests(
         unsigned int,
         std::vector<volk_test_results_t> *results = NULL,
         std::string puppet_master_name = "NULL",
-        bool benchmark_mode = false
+        bool benchmark_mode = false,
+        unsigned int trials = 1,
+        std::vector<unsigned int> bench_vlens = std::vector<unsigned int>(),
+        std::vector<volk_residency_t> residencies = std::vector<volk_residency_t>(),
+        bool counters = false,
+        std::ostream &out = std::cout
 );
 
 
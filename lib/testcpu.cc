@@ -0,0 +1,195 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Checks which machine get_machine() settles on for a set of CPU profiles.
+ * The cpu probe is linked against qa_cpu_stub.c, so cpuid and xgetbv
+ * answer from the profile; every profile runs in its own process because
+ * the probe and the machine are only looked up once. The first probe is
+ * raced by several threads, each of which must find volk_cpu filled in
+ * when volk_get_lvarch() returns.
+ */
+
+#include "qa_cpu_stub.h"
+#include "volk_machines.h"
+
+#include <volk/volk_cpu.h>
+
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern "C" struct volk_machine *get_machine(void);
+extern "C" struct volk_machine *volk_machines[];
+extern "C" unsigned int n_volk_machines;
+
+//cpuid(1).edx
+#define CPU_MMX     (1u << 23)
+#define CPU_SSE     (1u << 25)
+#define CPU_SSE2    (1u << 26)
+//cpuid(1).ecx
+#define CPU_SSE3    (1u << 0)
+#define CPU_SSSE3   (1u << 9)
+#define CPU_FMA     (1u << 12)
+#define CPU_SSE4_1  (1u << 19)
+#define CPU_SSE4_2  (1u << 20)
+#define CPU_POPCNT  (1u << 23)
+#define CPU_OSXSAVE (1u << 27)
+#define CPU_AVX     (1u << 28)
+//cpuid(7,0).ebx
+#define CPU_AVX2    (1u << 5)
+#define CPU_AVX512F (1u << 16)
+//cpuid(0x80000001)
+#define CPU_SSE4_A  (1u << 6)
+#define CPU_LM      (1u << 29)
+
+#define EDX_X86_64  (CPU_MMX | CPU_SSE | CPU_SSE2)
+#define ECX_SSE4_2  (CPU_SSE3 | CPU_SSSE3 | CPU_SSE4_1 | CPU_SSE4_2 | CPU_POPCNT)
+#define ECX_AVX     (ECX_SSE4_2 | CPU_OSXSAVE | CPU_AVX)
+#define ECX_AVX2    (ECX_AVX | CPU_FMA)
+
+struct cpu_profile_t {
+    const char *name;
+    volk_cpu_stub_profile_t regs;
+    const char *expected_machine;
+};
+
+static const cpu_profile_t cpu_profiles[] = {
+    {"no simd",            {0, 0, 0, 0, 0, 0x0},                                        "generic"},
+    {"sse2",               {0, EDX_X86_64, 0, 0, CPU_LM, 0x0},                           "sse2"},
+    {"sse3",               {CPU_SSE3, EDX_X86_64, 0, 0, CPU_LM, 0x0},                    "sse3"},
+    {"ssse3",              {CPU_SSE3 | CPU_SSSE3, EDX_X86_64, 0, 0, CPU_LM, 0x0},        "ssse3"},
+    {"sse4_a",             {CPU_SSE3 | CPU_POPCNT, EDX_X86_64, 0, CPU_SSE4_A, CPU_LM, 0x0}, "sse4_a"},
+    {"sse4_1",             {CPU_SSE3 | CPU_SSSE3 | CPU_SSE4_1, EDX_X86_64, 0, 0, CPU_LM, 0x0}, "sse4_1"},
+    {"sse4_2",             {ECX_SSE4_2, EDX_X86_64, 0, 0, CPU_LM, 0x0},                  "sse4_2"},
+    {"avx",                {ECX_AVX, EDX_X86_64, 0, 0, CPU_LM, 0x7},                     "avx"},
+    {"avx, no osxsave",    {ECX_AVX & ~CPU_OSXSAVE, EDX_X86_64, 0, 0, CPU_LM, 0x7},      "sse4_2"},
+    {"avx, xcr0 sse only", {ECX_AVX, EDX_X86_64, 0, 0, CPU_LM, 0x3},                     "sse4_2"},
+    {"avx, xcr0 ymm only", {ECX_AVX, EDX_X86_64, 0, 0, CPU_LM, 0x5},                     "sse4_2"},
+    {"avx2",               {ECX_AVX2, EDX_X86_64, CPU_AVX2, 0, CPU_LM, 0x7},             "avx2"},
+    {"avx2, xcr0 sse only",{ECX_AVX2, EDX_X86_64, CPU_AVX2, 0, CPU_LM, 0x3},             "sse4_2"},
+    {"avx512, xcr0 avx",   {ECX_AVX2, EDX_X86_64, CPU_AVX2 | CPU_AVX512F, 0, CPU_LM, 0x7}, "avx2"},
+    {"avx512, no zmm",     {ECX_AVX2, EDX_X86_64, CPU_AVX2 | CPU_AVX512F, 0, CPU_LM, 0x27}, "avx2"},
+    {"avx512",             {ECX_AVX2, EDX_X86_64, CPU_AVX2 | CPU_AVX512F, 0, CPU_LM, 0xE7}, "avx512"},
+};
+
+//machine names carry the archs they were built with, e.g. avx2_64_mmx_orc
+static bool machine_is(const char *machine, const char *expected)
+{
+    const size_t len = strlen(expected);
+    return strncmp(machine, expected, len) == 0 &&
+        (machine[len] == '\0' || machine[len] == '_');
+}
+
+static bool machine_compiled(const char *expected)
+{
+    for(unsigned int ii = 0; ii < n_volk_machines; ++ii) {
+        if(machine_is(volk_machines[ii]->name, expected)) return true;
+    }
+    return false;
+}
+
+static const unsigned int nracers = 16;
+
+//the mask from the first probe, or ~0 if volk_cpu was not ready yet
+static void *probe_racer(void *)
+{
+    const unsigned int lvarch = volk_get_lvarch();
+    if(volk_cpu.has_generic == NULL) return (void *)(size_t)~0u;
+    return (void *)(size_t)lvarch;
+}
+
+//runs in a forked child: 0 on the expected machine, 1 otherwise
+static int check_profile(const cpu_profile_t &profile)
+{
+    volk_cpu_stub_profile = profile.regs;
+
+    pthread_t racers[nracers];
+    unsigned int nracing = 0;
+    for(; nracing < nracers; nracing++) {
+        if(pthread_create(&racers[nracing], NULL, probe_racer, NULL) != 0) break;
+    }
+    const unsigned int lvarch = volk_get_lvarch();
+    bool raced_ok = true;
+    for(unsigned int t = 0; t < nracing; t++) {
+        void *ret = NULL;
+        pthread_join(racers[t], &ret);
+        if((unsigned int)(size_t)ret != lvarch) raced_ok = false;
+    }
+    if(!raced_ok) {
+        std::cerr << profile.name << ": a racing volk_get_lvarch() returned before volk_cpu was set up" << std::endl;
+        return 1;
+    }
+
+    const unsigned int ncalls = volk_cpu_stub_ncalls;
+    if(volk_get_lvarch() != lvarch || volk_cpu_stub_ncalls != ncalls) {
+        std::cerr << profile.name << ": volk_get_lvarch() probed the cpu twice" << std::endl;
+        return 1;
+    }
+
+    const char *machine = get_machine()->name;
+    if(!machine_is(machine, profile.expected_machine)) {
+        std::cerr << profile.name << ": expected " << profile.expected_machine
+                  << ", got " << machine << std::endl;
+        return 1;
+    }
+    std::cout << profile.name << ": " << machine << std::endl;
+    return 0;
+}
+
+int main()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    unsigned int nfails = 0;
+    const unsigned int nprofiles = sizeof(cpu_profiles)/sizeof(*cpu_profiles);
+
+    for(unsigned int ii = 0; ii < nprofiles; ++ii) {
+        const cpu_profile_t &profile = cpu_profiles[ii];
+        if(!machine_compiled(profile.expected_machine)) {
+            std::cout << profile.name << ": skipped, no "
+                      << profile.expected_machine << " machine in this build" << std::endl;
+            continue;
+        }
+
+        std::cout.flush();
+        pid_t pid = fork();
+        if(pid == 0) {
+            _exit(check_profile(profile));
+        }
+        int status = 1;
+        if(pid < 0 || waitpid(pid, &status, 0) != pid ||
+           !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            nfails++;
+        }
+    }
+
+    std::cerr << "CPU QA finished: " << nfails << " failures out of "
+              << nprofiles << " profiles." << std::endl;
+    return nfails != 0;
+#else
+    std::cout << "CPU QA skipped: the cpu stub only models x86" << std::endl;
+    return 0;
+#endif
+}
@@ -0,0 +1,206 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Checks the FFT plans against a direct DFT in double precision, for
+ * even and odd powers of two and both directions, in place and out of
+ * place. The largest size is checked by a forward and inverse round
+ * trip instead. The power path must match |X|^2 of the windowed
+ * transform, and unsupported sizes must not get a plan.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_fft.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+typedef std::complex<double> cdouble;
+
+// error relative to the largest bin, which is what float rounding scales with
+static double spectrum_error(const std::vector<cdouble> &ref, const lv_32fc_t *out, unsigned int n)
+{
+    double peak = 0.0, err = 0.0;
+    for(unsigned int k = 0; k < n; k++) {
+        peak = std::max(peak, std::abs(ref[k]));
+        err = std::max(err, std::abs(ref[k] - cdouble(lv_creal(out[k]), lv_cimag(out[k]))));
+    }
+    return err / peak;
+}
+
+static std::vector<cdouble> dft(const lv_32fc_t *in, unsigned int n, int sign)
+{
+    std::vector<cdouble> out(n);
+    for(unsigned int k = 0; k < n; k++) {
+        cdouble acc = 0.0;
+        for(unsigned int i = 0; i < n; i++) {
+            const double w = sign * 2.0 * M_PI * (double)(((unsigned long)i * k) % n) / n;
+            acc += cdouble(lv_creal(in[i]), lv_cimag(in[i])) * cdouble(std::cos(w), std::sin(w));
+        }
+        out[k] = acc;
+    }
+    return out;
+}
+
+static void random_samples(lv_32fc_t *buf, unsigned int n)
+{
+    for(unsigned int i = 0; i < n; i++)
+        buf[i] = lv_cmake(2.0f * rand() / RAND_MAX - 1.0f, 2.0f * rand() / RAND_MAX - 1.0f);
+}
+
+static int check_dft(unsigned int n, int inverse, bool in_place)
+{
+    volk_fft_plan_t *plan = volk_fft_plan_create(n, inverse);
+    if(plan == NULL || volk_fft_plan_size(plan) != n) {
+        std::cerr << "no plan for size " << n << std::endl;
+        return 1;
+    }
+    lv_32fc_t *in = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * n, volk_get_alignment());
+    lv_32fc_t *out = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * n, volk_get_alignment());
+    random_samples(in, n);
+    const std::vector<cdouble> ref = dft(in, n, inverse ? 1 : -1);
+
+    if(in_place) {
+        volk_fft_execute(plan, in, in);
+        for(unsigned int i = 0; i < n; i++) out[i] = in[i];
+    }
+    else {
+        volk_fft_execute(plan, out, in);
+    }
+
+    int nerrors = 0;
+    const double err = spectrum_error(ref, out, n);
+    if(err > 1e-5) {
+        std::cerr << "size " << n << (inverse ? " inverse" : " forward")
+                  << (in_place ? " in place" : "") << ": error " << err << std::endl;
+        nerrors++;
+    }
+    volk_free(in);
+    volk_free(out);
+    volk_fft_plan_destroy(plan);
+    return nerrors;
+}
+
+static int check_round_trip(unsigned int n)
+{
+    volk_fft_plan_t *fwd = volk_fft_plan_create(n, 0);
+    volk_fft_plan_t *inv = volk_fft_plan_create(n, 1);
+    if(fwd == NULL || inv == NULL) {
+        std::cerr << "no plan for size " << n << std::endl;
+        return 1;
+    }
+    lv_32fc_t *in = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * n, volk_get_alignment());
+    lv_32fc_t *out = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * n, volk_get_alignment());
+    random_samples(in, n);
+    volk_fft_execute(fwd, out, in);
+    volk_fft_execute(inv, out, out);
+
+    double err = 0.0;
+    for(unsigned int i = 0; i < n; i++)
+        err = std::max(err, (double)std::abs(out[i] / (float)n - in[i]));
+
+    int nerrors = 0;
+    if(err > 1e-5) {
+        std::cerr << "size " << n << " round trip: error " << err << std::endl;
+        nerrors++;
+    }
+    volk_free(in);
+    volk_free(out);
+    volk_fft_plan_destroy(fwd);
+    volk_fft_plan_destroy(inv);
+    return nerrors;
+}
+
+static int check_power(unsigned int n, int inverse)
+{
+    volk_fft_plan_t *plan = volk_fft_plan_create(n, inverse);
+    if(plan == NULL) {
+        std::cerr << "no plan for size " << n << std::endl;
+        return 1;
+    }
+    lv_32fc_t *in = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * n, volk_get_alignment());
+    lv_32fc_t *windowed = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * n, volk_get_alignment());
+    float *window = (float *)volk_malloc(sizeof(float) * n, volk_get_alignment());
+    float *power = (float *)volk_malloc(sizeof(float) * n, volk_get_alignment());
+    random_samples(in, n);
+    for(unsigned int i = 0; i < n; i++) {
+        window[i] = 0.5f - 0.5f * std::cos(2.0f * (float)M_PI * i / n);
+        windowed[i] = in[i] * window[i];
+    }
+    const std::vector<cdouble> ref = dft(windowed, n, inverse ? 1 : -1);
+    volk_fft_execute_power(plan, power, in, window);
+
+    double peak = 0.0, err = 0.0;
+    for(unsigned int k = 0; k < n; k++) {
+        peak = std::max(peak, std::norm(ref[k]));
+        err = std::max(err, std::abs(std::norm(ref[k]) - power[k]));
+    }
+
+    int nerrors = 0;
+    if(err / peak > 1e-5) {
+        std::cerr << "size " << n << (inverse ? " inverse" : " forward")
+                  << " power: error " << err / peak << std::endl;
+        nerrors++;
+    }
+    volk_free(in);
+    volk_free(windowed);
+    volk_free(window);
+    volk_free(power);
+    volk_fft_plan_destroy(plan);
+    return nerrors;
+}
+
+int main(void)
+{
+    int nerrors = 0;
+    srand(1);
+
+    for(unsigned int n = VOLK_FFT_MIN_SIZE; n <= 4096; n *= 2) {
+        nerrors += check_dft(n, 0, false);
+        nerrors += check_dft(n, 1, false);
+    }
+    nerrors += check_dft(512, 0, true);
+    nerrors += check_dft(2048, 1, true);
+    nerrors += check_round_trip(VOLK_FFT_MAX_SIZE);
+    nerrors += check_power(1024, 0);
+    nerrors += check_power(128, 1);
+
+    const unsigned int bad_sizes[] = {0, 32, 48, 1000, 2 * VOLK_FFT_MAX_SIZE};
+    for(unsigned int i = 0; i < sizeof(bad_sizes) / sizeof(bad_sizes[0]); i++) {
+        volk_fft_plan_t *plan = volk_fft_plan_create(bad_sizes[i], 0);
+        if(plan != NULL) {
+            std::cerr << "got a plan for size " << bad_sizes[i] << std::endl;
+            volk_fft_plan_destroy(plan);
+            nerrors++;
+        }
+    }
+
+    if(nerrors != 0) {
+        std::cerr << nerrors << " FFT checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "FFT checks passed on machine " << volk_get_machine() << std::endl;
+    return 0;
+}
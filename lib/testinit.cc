@@ -0,0 +1,386 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Races the lazy dispatcher initialisation: every round forks a fresh
+ * process in which 64 threads make their first volk calls at the same
+ * time, on aligned and misaligned buffers, and check the results. The
+ * last rounds bind everything with volk_init() before the threads start,
+ * once with the default ranking and once with a config of length buckets.
+ * When volk is built with ENABLE_STATS a round checks that the
+ * per-thread dispatcher counters add up over all racing threads. With
+ * ENABLE_IFUNC the threads also call the load time resolved entries. The
+ * last round runs peelable kernels on misaligned buffers, which the
+ * dispatchers split into an unaligned prologue and an aligned body.
+ * A final round checks that volk_fp_env_enter flushes denormals on SSE
+ * machines and that volk_fp_env_leave restores gradual underflow.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+#include <volk/volk_prefs.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const unsigned int nthreads = 64;
+static const unsigned int nrounds = 16;
+static const unsigned int vlen = 1021;
+
+static pthread_mutex_t start_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;
+static bool started = false;
+
+static bool close_enough(float a, float b, float tol)
+{
+    return std::fabs(a - b) <= tol * std::fmax(1.0f, std::fabs(b));
+}
+
+//calls a few kernels through their dispatchers; returns the number of errors
+static long first_calls(unsigned int thread_id)
+{
+    long nerrors = 0;
+    const size_t alignment = volk_get_alignment();
+    float *a = (float *)volk_malloc((vlen + 1) * sizeof(float), alignment);
+    float *b = (float *)volk_malloc((vlen + 1) * sizeof(float), alignment);
+    float *c = (float *)volk_malloc((vlen + 1) * sizeof(float), alignment);
+    lv_32fc_t *x = (lv_32fc_t *)volk_malloc((vlen + 1) * sizeof(lv_32fc_t), alignment);
+    lv_32fc_t *y = (lv_32fc_t *)volk_malloc((vlen + 1) * sizeof(lv_32fc_t), alignment);
+    lv_32fc_t *z = (lv_32fc_t *)volk_malloc((vlen + 1) * sizeof(lv_32fc_t), alignment);
+
+    for(unsigned int i = 0; i < vlen + 1; i++) {
+        a[i] = (float)(i % 17) - 8.0f;
+        b[i] = (float)(i % 5) + 0.5f;
+        x[i] = lv_cmake((float)(i % 7) - 3.0f, 0.25f * (float)(i % 3));
+        y[i] = lv_cmake(0.5f, (float)(i % 11) - 5.0f);
+    }
+
+    //odd threads start misaligned so both the _a and _u bindings race
+    const unsigned int off = thread_id & 1;
+
+    volk_32f_x2_add_32f(c + off, a + off, b + off, vlen);
+    for(unsigned int i = 0; i < vlen; i++) {
+        if(c[i + off] != a[i + off] + b[i + off]) nerrors++;
+    }
+
+#if defined(VOLK_IFUNC)
+    //the load time resolved entry, which branches on alignment itself
+    std::memset(c, 0, (vlen + 1) * sizeof(float));
+    volk_32f_x2_add_32f_ifunc(c + off, a + off, b + off, vlen);
+    for(unsigned int i = 0; i < vlen; i++) {
+        if(c[i + off] != a[i + off] + b[i + off]) nerrors++;
+    }
+#endif
+
+    volk_32fc_x2_multiply_32fc(z + off, x + off, y + off, vlen);
+    for(unsigned int i = 0; i < vlen; i++) {
+        const lv_32fc_t expected = x[i + off] * y[i + off];
+        if(!close_enough(lv_creal(z[i + off]), lv_creal(expected), 1e-5f) ||
+           !close_enough(lv_cimag(z[i + off]), lv_cimag(expected), 1e-5f)) nerrors++;
+    }
+
+    float dot = 0.0f, expected_dot = 0.0f;
+    volk_32f_x2_dot_prod_32f(&dot, a + off, b + off, vlen);
+    for(unsigned int i = 0; i < vlen; i++) expected_dot += a[i + off] * b[i + off];
+    if(!close_enough(dot, expected_dot, 1e-4f)) nerrors++;
+
+    volk_free(a);
+    volk_free(b);
+    volk_free(c);
+    volk_free(x);
+    volk_free(y);
+    volk_free(z);
+    return nerrors;
+}
+
+static void *racer(void *arg)
+{
+    pthread_mutex_lock(&start_lock);
+    while(!started) pthread_cond_wait(&start_cond, &start_lock);
+    pthread_mutex_unlock(&start_lock);
+    return (void *)first_calls((unsigned int)(size_t)arg);
+}
+
+//runs in a freshly forked child so no kernel has been bound yet
+static int run_round(void)
+{
+    pthread_t threads[nthreads];
+    long nerrors = 0;
+
+    for(unsigned int t = 0; t < nthreads; t++) {
+        if(pthread_create(&threads[t], NULL, racer, (void *)(size_t)t) != 0) {
+            std::cerr << "failed to create thread " << t << std::endl;
+            return 1;
+        }
+    }
+
+    pthread_mutex_lock(&start_lock);
+    started = true;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&start_lock);
+
+    for(unsigned int t = 0; t < nthreads; t++) {
+        void *ret = NULL;
+        pthread_join(threads[t], &ret);
+        nerrors += (long)ret;
+    }
+
+    if(nerrors) std::cerr << nerrors << " wrong results" << std::endl;
+    return nerrors != 0;
+}
+
+//volk_init() must bind everything up front: the first calls rebind nothing
+static int run_eager_init(void)
+{
+    const double elapsed = volk_init();
+    const p_32f_x2_add_32f bound_a = volk_32f_x2_add_32f_a;
+    const p_32f_x2_add_32f bound_u = volk_32f_x2_add_32f_u;
+
+    if(elapsed < 0.0) {
+        std::cerr << "volk_init reported " << elapsed << " seconds" << std::endl;
+        return 1;
+    }
+    if(run_round() != 0) return 1;
+    if(volk_32f_x2_add_32f_a != bound_a || volk_32f_x2_add_32f_u != bound_u) {
+        std::cerr << "volk_init left volk_32f_x2_add_32f unbound" << std::endl;
+        return 1;
+    }
+    std::cout << "volk_init took " << elapsed * 1e3 << " ms" << std::endl;
+    return 0;
+}
+
+//vlen falls in the middle bucket; the last, out of order one is dropped
+static int run_bucketed_init(void)
+{
+    const volk_func_desc_t desc = volk_32f_x2_add_32f_get_func_desc();
+    const char *impl_u = desc.impl_names[0];
+    for(size_t i = 0; i < desc.n_impls; i++) {
+        if(!desc.impl_alignment[i]) impl_u = desc.impl_names[i];
+    }
+
+    char path[] = "/tmp/volk_config_XXXXXX";
+    const int fd = mkstemp(path);
+    FILE *config = (fd < 0)? NULL : fdopen(fd, "w");
+    if(config == NULL) {
+        std::cerr << "cannot create a temporary volk_config" << std::endl;
+        return 1;
+    }
+    fprintf(config, "volk_32f_x2_add_32f generic generic 16 generic generic %u %s %s 8 generic generic\n",
+            2 * vlen, impl_u, impl_u);
+    fclose(config);
+
+    volk_arch_pref_ex_t *prefs = NULL;
+    const size_t n_prefs = volk_load_preferences_from(path, &prefs);
+    const bool parsed = n_prefs == 1 && prefs[0].n_buckets == 2 &&
+        prefs[0].buckets[0].max_len == 16 && prefs[0].buckets[1].max_len == 2 * vlen &&
+        !strcmp(prefs[0].buckets[1].impl_a, impl_u) && !strcmp(prefs[0].buckets[1].impl_u, impl_u);
+    free(prefs);
+    if(!parsed) {
+        std::cerr << "length buckets not parsed from the config" << std::endl;
+        remove(path);
+        return 1;
+    }
+
+    prefs = NULL;
+    std::string missing = std::string(path) + ".missing";
+    if(volk_load_preferences_from(missing.c_str(), &prefs) != VOLK_PREFS_UNREADABLE || prefs != NULL) {
+        std::cerr << "a missing config is not reported as unreadable" << std::endl;
+        remove(path);
+        return 1;
+    }
+
+    volk_init_with_config(path);
+    remove(path);
+    return run_round();
+}
+
+//every thread called volk_32f_x2_add_32f once, half of them aligned
+static int run_stats(void)
+{
+    volk_kernel_stats_t stats[1024];
+    if(run_round() != 0) return 1;
+    const size_t n_stats = volk_get_stats(stats, 1024);
+    if(n_stats == 0) {
+        std::cout << "volk built without kernel statistics" << std::endl;
+        return 0;
+    }
+
+    unsigned int bin = 0;
+    for(unsigned int len = vlen; len != 0; len >>= 1) bin++;
+    for(size_t k = 0; k < n_stats && k < 1024; k++) {
+        if(strcmp(stats[k].name, "volk_32f_x2_add_32f") != 0) continue;
+        if(stats[k].calls != nthreads || stats[k].points != (uint64_t)nthreads * vlen ||
+           stats[k].aligned_calls != nthreads / 2 || stats[k].len_hist[bin] != nthreads) {
+            std::cerr << "volk_32f_x2_add_32f counted " << stats[k].calls << " calls, "
+                      << stats[k].points << " points, " << stats[k].aligned_calls
+                      << " aligned" << std::endl;
+            return 1;
+        }
+        volk_dump_stats();
+        fflush(stdout);
+        return 0;
+    }
+    std::cerr << "no statistics for volk_32f_x2_add_32f" << std::endl;
+    return 1;
+}
+
+//every offset below the alignment, shared by all buffers or not
+static int run_peeled(void)
+{
+    static const unsigned int lens[] = {1, 7, 33, 1021};
+    const size_t alignment = volk_get_alignment();
+    const unsigned int max_off = (unsigned int)alignment;
+    const unsigned int n = vlen + 2 * max_off;
+    float *in = (float *)volk_malloc(n * sizeof(float), alignment);
+    float *out = (float *)volk_malloc(n * sizeof(float), alignment);
+    float *expected = (float *)volk_malloc(n * sizeof(float), alignment);
+    lv_8sc_t *in_8ic = (lv_8sc_t *)volk_malloc(n * sizeof(lv_8sc_t), alignment);
+    int8_t *out_8i = (int8_t *)volk_malloc(n, alignment);
+    int8_t *expected_8i = (int8_t *)volk_malloc(n, alignment);
+    long nerrors = 0;
+
+    volk_init();
+    for(unsigned int i = 0; i < n; i++) {
+        in[i] = 0.5f + (float)(i % 13) * 0.25f;
+        in_8ic[i] = lv_cmake((int8_t)(i % 251 - 125), (int8_t)(i % 7));
+    }
+
+    for(unsigned int l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+        const unsigned int len = lens[l];
+        for(unsigned int off = 0; off < max_off; off++) {
+            for(unsigned int shift = 0; shift < 2; shift++) {
+                volk_32f_s32f_power_32f_manual(expected + off, in + off + shift, 1.5f, len, "generic");
+                volk_32f_s32f_power_32f(out + off, in + off + shift, 1.5f, len);
+                for(unsigned int i = 0; i < len; i++) {
+                    if(!close_enough(out[off + i], expected[off + i], 1e-4f)) nerrors++;
+                }
+
+                volk_8ic_deinterleave_real_8i_manual(expected_8i + off, in_8ic + off + shift, len, "generic");
+                volk_8ic_deinterleave_real_8i(out_8i + off, in_8ic + off + shift, len);
+                if(memcmp(out_8i + off, expected_8i + off, len) != 0) nerrors++;
+            }
+        }
+    }
+
+    volk_free(in);
+    volk_free(out);
+    volk_free(expected);
+    volk_free(in_8ic);
+    volk_free(out_8i);
+    volk_free(expected_8i);
+    if(nerrors) std::cerr << nerrors << " wrong results from peeled calls" << std::endl;
+    return nerrors != 0;
+}
+
+//denormals go to zero between enter and leave, on machines that say so
+static int run_fp_env(void)
+{
+    const float denormal = 1e-39f;
+    float in[4] = {denormal, denormal, 1.0f, -denormal};
+    float out[4];
+    long nerrors = 0;
+
+    volk_init();
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    const bool flushes = std::strcmp(volk_get_machine(), "generic") != 0;
+#else
+    const bool flushes = false;
+#endif
+
+    volk_fp_env_t env;
+    volk_fp_env_enter(&env);
+    volk_32f_s32f_multiply_32f(out, in, 1.0f, 4);
+    for(unsigned int i = 0; i < 4; i++) {
+        const float expected = (flushes && in[i] != 1.0f) ? 0.0f : in[i];
+        if(out[i] != expected) nerrors++;
+    }
+    volk_fp_env_leave(&env);
+
+    volk_32f_s32f_multiply_32f(out, in, 1.0f, 4);
+    for(unsigned int i = 0; i < 4; i++) {
+        if(out[i] != in[i]) nerrors++;
+    }
+
+    if(nerrors) std::cerr << nerrors << " wrong results around the fp environment" << std::endl;
+    return nerrors != 0;
+}
+
+static bool run_child(int (*fn)(void))
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid == 0) {
+        _exit(fn());
+    }
+    int status = 1;
+    return pid >= 0 && waitpid(pid, &status, 0) == pid &&
+        WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main()
+{
+    unsigned int nfails = 0;
+
+    for(unsigned int round = 0; round < nrounds; round++) {
+        if(!run_child(run_round)) {
+            std::cerr << "round " << round << " failed" << std::endl;
+            nfails++;
+        }
+    }
+
+    if(!run_child(run_eager_init)) {
+        std::cerr << "eager init round failed" << std::endl;
+        nfails++;
+    }
+
+    if(!run_child(run_bucketed_init)) {
+        std::cerr << "bucketed init round failed" << std::endl;
+        nfails++;
+    }
+
+    if(!run_child(run_stats)) {
+        std::cerr << "stats round failed" << std::endl;
+        nfails++;
+    }
+
+    if(!run_child(run_peeled)) {
+        std::cerr << "peeled round failed" << std::endl;
+        nfails++;
+    }
+
+    if(!run_child(run_fp_env)) {
+        std::cerr << "fp environment round failed" << std::endl;
+        nfails++;
+    }
+
+    std::cerr << "Init QA finished: " << nfails << " failures out of "
+              << nrounds << " rounds of " << nthreads << " threads." << std::endl;
+    return nfails != 0;
+}
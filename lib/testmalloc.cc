@@ -0,0 +1,404 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Checks the scratch arena: alignment and independence of the buffers,
+ * nested marks, growth past the arena chunks and the steady state in
+ * which a loop gets the same buffers on every iteration, also while an
+ * outer buffer is held. A few threads repeat the loop at once to check
+ * the arenas are per thread.
+ *
+ * Everything runs twice in forked children, with the volk_malloc pool
+ * off and on. The pool rounds also churn blocks of every size class
+ * through several threads, with frees in other threads than the
+ * allocations, so batches travel through the global free list, and
+ * check that the blocks cached by a thread come back after it exits.
+ *
+ * volk_malloc_ex is checked for every flag, with whatever huge pages
+ * and NUMA support the host has: the buffer must be usable and the
+ * flags it reports must be ones asked for or their fallbacks.
+ *
+ * A volk_ringbuf must show every write through both of its mappings,
+ * and a size too large to double map must be refused.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+#include <volk/volk_ringbuf.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const unsigned int nthreads = 8;
+static const unsigned int nslots = 64;
+
+static bool is_aligned(const void *ptr, size_t alignment)
+{
+    return ((uintptr_t)ptr & (alignment - 1)) == 0;
+}
+
+//one decoder-like iteration: three buffers, filled and checked
+static long iteration(size_t n, void **first)
+{
+    long nerrors = 0;
+    const size_t mark = volk_scratch_mark();
+    unsigned char *a = (unsigned char *)volk_scratch_get(n, 16);
+    unsigned char *b = (unsigned char *)volk_scratch_get(n / 2 + 1, 64);
+    float *c = (float *)volk_scratch_get(n * sizeof(float), volk_get_alignment());
+    if(a == NULL || b == NULL || c == NULL) return 1;
+    if(!is_aligned(a, 16) || !is_aligned(b, 64) || !is_aligned(c, volk_get_alignment())) nerrors++;
+
+    std::memset(a, 0x5a, n);
+    std::memset(b, 0xa5, n / 2 + 1);
+    for(size_t i = 0; i < n; i++) c[i] = (float)i;
+
+    //a nested user gets fresh memory and gives it back
+    const size_t inner = volk_scratch_mark();
+    unsigned char *d = (unsigned char *)volk_scratch_get(n, 32);
+    if(d == NULL) return nerrors + 1;
+    std::memset(d, 0xff, n);
+    volk_scratch_release(inner);
+    if(volk_scratch_mark() != inner) nerrors++;
+
+    for(size_t i = 0; i < n; i++) {
+        if(a[i] != 0x5a || c[i] != (float)i) nerrors++;
+    }
+    for(size_t i = 0; i < n / 2 + 1; i++) {
+        if(b[i] != 0xa5) nerrors++;
+    }
+    *first = a;
+    volk_scratch_release(mark);
+    if(volk_scratch_mark() != mark) nerrors++;
+    return nerrors;
+}
+
+static long scratch_loop(void)
+{
+    long nerrors = 0;
+    void *first = NULL;
+    void *previous = NULL;
+
+    //growing sizes overflow the arena block until it is regrown
+    for(size_t n = 1; n <= 65536; n *= 4) {
+        nerrors += iteration(n, &first);
+    }
+
+    //at steady state the arena hands out the same memory every time
+    nerrors += iteration(65536, &previous);
+    for(unsigned int i = 0; i < 16; i++) {
+        nerrors += iteration(65536, &first);
+        if(first != previous) nerrors++;
+        nerrors += iteration(1000, &first);
+        if(first != previous) nerrors++;
+    }
+
+    //a buffer held across the loop, from a fresh arena, must not stop the reuse
+    volk_scratch_free();
+    const size_t outer = volk_scratch_mark();
+    if(volk_scratch_get(100, 16) == NULL) nerrors++;
+    nerrors += iteration(65536, &previous);
+    for(unsigned int i = 0; i < 16; i++) {
+        nerrors += iteration(65536, &first);
+        if(first != previous) nerrors++;
+    }
+    volk_scratch_release(outer);
+
+    if(volk_scratch_get(16, 3) != NULL) nerrors++;
+    volk_scratch_free();
+    return nerrors;
+}
+
+static void *scratch_thread(void *)
+{
+    return (void *)scratch_loop();
+}
+
+//allocates into its own slots and frees what the previous thread left
+struct churn_args {
+    void **slots;
+    size_t *sizes;
+    unsigned int thread_id;
+    long nerrors;
+};
+
+static pthread_barrier_t churn_barrier;
+
+static void *churn_thread(void *arg)
+{
+    churn_args *args = (churn_args *)arg;
+    const size_t alignment = volk_get_alignment();
+    void **mine = args->slots + args->thread_id * nslots;
+    size_t *my_sizes = args->sizes + args->thread_id * nslots;
+    void **theirs = args->slots + ((args->thread_id + 1) % nthreads) * nslots;
+
+    for(unsigned int round = 0; round < 8; round++) {
+        for(unsigned int i = 0; i < nslots; i++) {
+            const size_t size = (size_t)1 << ((i + round + args->thread_id) % 22);
+            unsigned char *ptr = (unsigned char *)volk_malloc(size, alignment);
+            if(ptr == NULL || !is_aligned(ptr, alignment)) {
+                args->nerrors++;
+                mine[i] = NULL;
+                continue;
+            }
+            std::memset(ptr, (int)(i & 0xff), size);
+            mine[i] = ptr;
+            my_sizes[i] = size;
+        }
+        pthread_barrier_wait(&churn_barrier);
+
+        //every block still holds what its owner wrote
+        const size_t *their_sizes = args->sizes + (theirs - args->slots);
+        for(unsigned int i = 0; i < nslots; i++) {
+            const unsigned char *ptr = (const unsigned char *)theirs[i];
+            if(ptr == NULL) continue;
+            if(ptr[0] != (i & 0xff) || ptr[their_sizes[i] - 1] != (i & 0xff)) args->nerrors++;
+        }
+        pthread_barrier_wait(&churn_barrier);
+        for(unsigned int i = 0; i < nslots; i++) {
+            volk_free(theirs[i]);
+        }
+        pthread_barrier_wait(&churn_barrier);
+    }
+    return NULL;
+}
+
+static long pool_churn(void)
+{
+    long nerrors = 0;
+
+    //a freed block comes straight back for the same class
+    void *a = volk_malloc(1000, volk_get_alignment());
+    volk_free(a);
+    void *b = volk_malloc(1024, volk_get_alignment());
+    if(volk_malloc_is_pooled() && a != b) nerrors++;
+    volk_free(b);
+
+    //alignments beyond the pool's still hold
+    for(size_t alignment = 16; alignment <= 4096; alignment *= 2) {
+        void *ptr = volk_malloc(100, alignment);
+        if(ptr == NULL || !is_aligned(ptr, alignment)) nerrors++;
+        volk_free(ptr);
+    }
+    volk_free(NULL);
+
+    std::vector<void *> slots(nthreads * nslots);
+    std::vector<size_t> sizes(nthreads * nslots);
+    churn_args args[nthreads];
+    pthread_t threads[nthreads];
+    pthread_barrier_init(&churn_barrier, NULL, nthreads);
+    for(unsigned int t = 0; t < nthreads; t++) {
+        args[t].slots = slots.data();
+        args[t].sizes = sizes.data();
+        args[t].thread_id = t;
+        args[t].nerrors = 0;
+        if(pthread_create(&threads[t], NULL, churn_thread, &args[t]) != 0) {
+            std::cerr << "could not start thread " << t << std::endl;
+            return nerrors + 1;
+        }
+    }
+    for(unsigned int t = 0; t < nthreads; t++) {
+        pthread_join(threads[t], NULL);
+        nerrors += args[t].nerrors;
+    }
+    pthread_barrier_destroy(&churn_barrier);
+    return nerrors;
+}
+
+static const unsigned int nexit_blocks = 8;
+
+static void *exit_thread(void *arg)
+{
+    void **blocks = (void **)arg;
+    for(unsigned int i = 0; i < nexit_blocks; i++) {
+        blocks[i] = volk_malloc(8192, volk_get_alignment());
+    }
+    for(unsigned int i = 0; i < nexit_blocks; i++) {
+        volk_free(blocks[i]);
+    }
+    return NULL;
+}
+
+//a fresh thread's cache is empty, so it takes the batch pushed last
+static void *reuse_thread(void *arg)
+{
+    void **cached = (void **)arg;
+    long nerrors = 0;
+    void *again[nexit_blocks];
+    for(unsigned int i = 0; i < nexit_blocks; i++) {
+        again[i] = volk_malloc(8192, volk_get_alignment());
+        bool found = false;
+        for(unsigned int j = 0; j < nexit_blocks; j++) {
+            found = found || again[i] == cached[j];
+        }
+        if(!found) nerrors++;
+    }
+    for(unsigned int i = 0; i < nexit_blocks; i++) {
+        volk_free(again[i]);
+    }
+    return (void *)nerrors;
+}
+
+//the blocks an exited thread had cached are the next ones handed out
+static long pool_thread_exit(void)
+{
+    void *cached[nexit_blocks];
+    void *ret = NULL;
+    pthread_t thread;
+    if(!volk_malloc_is_pooled()) return 0;
+    if(pthread_create(&thread, NULL, exit_thread, cached) != 0) return 1;
+    pthread_join(thread, NULL);
+    if(pthread_create(&thread, NULL, reuse_thread, cached) != 0) return 1;
+    pthread_join(thread, &ret);
+    return (long)ret;
+}
+
+static long malloc_ex(void)
+{
+    static const unsigned int flags[] = {
+        VOLK_MALLOC_DEFAULT,
+        VOLK_MALLOC_PREFAULT,
+        VOLK_MALLOC_HUGE_PAGES,
+        VOLK_MALLOC_HUGE_PAGES | VOLK_MALLOC_PREFAULT,
+        VOLK_MALLOC_HUGE_TLB,
+        VOLK_MALLOC_HUGE_TLB | VOLK_MALLOC_PREFAULT | VOLK_MALLOC_NODE(0),
+        VOLK_MALLOC_HUGE_TLB | VOLK_MALLOC_NO_FALLBACK,
+        VOLK_MALLOC_NODE(0),
+        VOLK_MALLOC_NODE(0) | VOLK_MALLOC_PREFAULT,
+    };
+    static const size_t lens[] = {1, 4096, 3 * 1024 * 1024 + 5};
+    long nerrors = 0;
+
+    for(unsigned int f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+        for(unsigned int l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+            unsigned char *ptr = (unsigned char *)volk_malloc_ex(lens[l], flags[f]);
+            if(ptr == NULL) {
+                if(!(flags[f] & VOLK_MALLOC_NO_FALLBACK)) nerrors++;
+                continue;
+            }
+            if(!is_aligned(ptr, 64)) nerrors++;
+            //explicit huge pages fall back to transparent ones
+            unsigned int allowed = flags[f];
+            if(allowed & VOLK_MALLOC_HUGE_TLB) allowed |= VOLK_MALLOC_HUGE_PAGES;
+            const unsigned int applied = volk_malloc_ex_flags(ptr);
+            if((applied & ~allowed) != 0) nerrors++;
+            //huge page buffers start on a huge page, with nothing in front
+            if((applied & (VOLK_MALLOC_HUGE_PAGES | VOLK_MALLOC_HUGE_TLB)) &&
+               !is_aligned(ptr, 2 * 1024 * 1024)) nerrors++;
+            std::memset(ptr, 0x3c, lens[l]);
+            if(ptr[0] != 0x3c || ptr[lens[l] - 1] != 0x3c) nerrors++;
+            volk_free_ex(ptr);
+        }
+    }
+    volk_free_ex(NULL);
+    return nerrors;
+}
+
+static long ringbuf(void)
+{
+    long nerrors = 0;
+    size_t size = 0;
+    float *ring = (float *)volk_ringbuf_alloc(1000 * sizeof(float), &size);
+    if(ring == NULL) return 1;
+    if(size < 1000 * sizeof(float) || size % volk_get_alignment() != 0) nerrors++;
+    if(!is_aligned(ring, volk_get_alignment())) nerrors++;
+
+    //a stream written around the wrap reads back in order across it
+    const size_t len = size / sizeof(float);
+    for(size_t i = 0; i < len + 100; i++) ring[i % len] = (float)i;
+    for(size_t i = len - 100; i < len + 100; i++) {
+        if(ring[i] != (float)i) nerrors++;
+    }
+    ring[len + 7] = -1.0f;
+    if(ring[7] != -1.0f) nerrors++;
+
+    volk_ringbuf_free(ring, size);
+    volk_ringbuf_free(NULL, 0);
+
+    //a size whose rounding or doubling would wrap is refused
+    errno = 0;
+    if(volk_ringbuf_alloc(SIZE_MAX - 1, &size) != NULL || errno != EINVAL) nerrors++;
+    return nerrors;
+}
+
+static int run_all(void)
+{
+    long nerrors = scratch_loop();
+
+    pthread_t threads[nthreads];
+    for(unsigned int t = 0; t < nthreads; t++) {
+        if(pthread_create(&threads[t], NULL, scratch_thread, NULL) != 0) {
+            std::cerr << "could not start thread " << t << std::endl;
+            return 1;
+        }
+    }
+    for(unsigned int t = 0; t < nthreads; t++) {
+        void *ret = NULL;
+        pthread_join(threads[t], &ret);
+        nerrors += (long)ret;
+    }
+
+    nerrors += pool_churn();
+    nerrors += pool_thread_exit();
+    nerrors += malloc_ex();
+    nerrors += ringbuf();
+    if(nerrors) std::cerr << nerrors << " errors" << std::endl;
+    return nerrors != 0;
+}
+
+static bool run_child(const char *pool)
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid == 0) {
+        setenv("VOLK_MALLOC_POOL", pool, 1);
+        if(volk_malloc_is_pooled() != (pool[0] == '1')) _exit(1);
+        _exit(run_all());
+    }
+    int status = 1;
+    return pid >= 0 && waitpid(pid, &status, 0) == pid &&
+        WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main()
+{
+    unsigned int nfails = 0;
+
+    if(!run_child("0")) {
+        std::cerr << "system allocator round failed" << std::endl;
+        nfails++;
+    }
+
+    if(!run_child("1")) {
+        std::cerr << "pool round failed" << std::endl;
+        nfails++;
+    }
+
+    std::cerr << "Malloc QA finished: " << nfails << " failures." << std::endl;
+    return nfails != 0;
+}
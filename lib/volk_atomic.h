@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/*
+ * Minimal atomics for publishing the lazily initialised dispatcher state.
+ * The GCC/clang builtins work on any pointer sized object, including the
+ * typed kernel function pointers, so no casts are needed at the call site.
+ */
+
+#ifndef INCLUDED_VOLK_ATOMIC_H
+#define INCLUDED_VOLK_ATOMIC_H
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define volk_atomic_load_relaxed(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define volk_atomic_load_acquire(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define volk_atomic_store_relaxed(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#define volk_atomic_store_release(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+
+//stores desired if *ptr == *expected, otherwise loads *ptr into *expected
+#define volk_atomic_cas(ptr, expected, desired) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+#else
+
+//Without compiler atomics fall back to plain accesses: pointer sized
+//stores do not tear on the targets volk supports and racing initialisers
+//all store the same values, so the worst case is a redundant init
+#define volk_atomic_load_relaxed(ptr) (*(ptr))
+#define volk_atomic_load_acquire(ptr) (*(ptr))
+#define volk_atomic_store_relaxed(ptr, val) (*(ptr) = (val))
+#define volk_atomic_store_release(ptr, val) (*(ptr) = (val))
+#define volk_atomic_cas(ptr, expected, desired) \
+    ((*(ptr) == *(expected))? (*(ptr) = (desired), 1) : (*(expected) = *(ptr), 0))
+
+#endif
+
+#endif /*INCLUDED_VOLK_ATOMIC_H*/
@@ -0,0 +1,138 @@
+/* -*- c -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * FFT plans: a Stockham transform made of volk_32fc_x2_fft_radix4_32fc
+ * passes. The passes ping-pong between the two work buffers and the
+ * last one writes wherever the caller wants the spectrum. The inverse
+ * conjugates on the way in and out rather than keeping a second set of
+ * butterflies.
+ */
+
+#include <volk/volk.h>
+#include <volk/volk_fft.h>
+#include <volk/volk_32fc_x2_fft_radix4_32fc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct volk_fft_plan
+{
+  unsigned int fft_size;
+  int inverse;
+  lv_32fc_t *twiddles;
+  lv_32fc_t *work[2];
+};
+
+volk_fft_plan_t *volk_fft_plan_create(unsigned int fft_size, int inverse)
+{
+  const size_t alignment = volk_get_alignment();
+  volk_fft_plan_t *plan;
+
+  if (fft_size < VOLK_FFT_MIN_SIZE || fft_size > VOLK_FFT_MAX_SIZE ||
+      (fft_size & (fft_size - 1)) != 0) {
+    fprintf(stderr, "VOLK: Unsupported FFT size %u\n", fft_size);
+    return NULL;
+  }
+
+  plan = (volk_fft_plan_t *)calloc(1, sizeof(volk_fft_plan_t));
+  if (plan == NULL)
+    return NULL;
+  plan->fft_size = fft_size;
+  plan->inverse = inverse != 0;
+  plan->twiddles = (lv_32fc_t *)volk_malloc(
+      sizeof(lv_32fc_t) * fft_radix4_twiddles_size(fft_size), alignment);
+  plan->work[0] = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * fft_size, alignment);
+  plan->work[1] = (lv_32fc_t *)volk_malloc(sizeof(lv_32fc_t) * fft_size, alignment);
+  if (plan->twiddles == NULL || plan->work[0] == NULL || plan->work[1] == NULL) {
+    volk_fft_plan_destroy(plan);
+    return NULL;
+  }
+  fft_radix4_twiddles(plan->twiddles, fft_size);
+  return plan;
+}
+
+// runs every pass from src into dst; only the first pass reads src,
+// and it must not be work[0]
+static void fft_passes(volk_fft_plan_t *plan, lv_32fc_t *dst, const lv_32fc_t *src)
+{
+  const unsigned int N = plan->fft_size;
+  const lv_32fc_t *tw = plan->twiddles;
+  unsigned int stride, pass = 0;
+
+  for (stride = 1; stride < N; stride *= 4, pass++) {
+    lv_32fc_t *to = (stride * 4 < N) ? plan->work[pass % 2] : dst;
+    volk_32fc_x2_fft_radix4_32fc(to, src, tw, stride, N);
+    tw += 3 * (N / stride / 4);
+    src = to;
+  }
+}
+
+void volk_fft_execute(volk_fft_plan_t *plan, lv_32fc_t *out, const lv_32fc_t *in)
+{
+  if (plan->inverse) {
+    volk_32fc_conjugate_32fc(plan->work[1], in, plan->fft_size);
+    fft_passes(plan, out, plan->work[1]);
+    volk_32fc_conjugate_32fc(out, out, plan->fft_size);
+  } else {
+    fft_passes(plan, out, in);
+  }
+}
+
+void volk_fft_execute_power(volk_fft_plan_t *plan, float *out,
+                            const lv_32fc_t *in, const float *window)
+{
+  const unsigned int N = plan->fft_size;
+  unsigned int stride, passes = 0;
+  lv_32fc_t *spectrum;
+
+  // the last pass lands in the work buffer the one before did not use
+  for (stride = 1; stride < N; stride *= 4)
+    passes++;
+  spectrum = plan->work[(passes - 1) % 2];
+
+  if (window != NULL) {
+    volk_32fc_32f_multiply_32fc(plan->work[1], in, window, N);
+    in = plan->work[1];
+  }
+  // the conjugate on the way out does not change |X|^2
+  if (plan->inverse) {
+    volk_32fc_conjugate_32fc(plan->work[1], in, N);
+    in = plan->work[1];
+  }
+  fft_passes(plan, spectrum, in);
+  volk_32fc_magnitude_squared_32f(out, spectrum, N);
+}
+
+unsigned int volk_fft_plan_size(const volk_fft_plan_t *plan)
+{
+  return plan->fft_size;
+}
+
+void volk_fft_plan_destroy(volk_fft_plan_t *plan)
+{
+  if (plan == NULL)
+    return;
+  volk_free(plan->twiddles);
+  volk_free(plan->work[0]);
+  volk_free(plan->work[1]);
+  free(plan);
+}
@@ -20,7 +20,14 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // MAP_HUGETLB, MADV_HUGEPAGE
+#endif
+
 #include <volk/volk_malloc.h>
+#include <volk/volk.h>
+#include "volk_atomic.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,7 +42,7 @@
 // multiple of sizeof(void *).
 #if _POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600 || HAVE_POSIX_MEMALIGN
 
-void *volk_malloc(size_t size, size_t alignment)
+static void *system_malloc(size_t size, size_t alignment)
 {
   void *ptr;
 
@@ -57,7 +64,7 @@ void *volk_malloc(size_t size, size_t alignment)
   }
 }
 
-void volk_free(void *ptr)
+static void system_free(void *ptr)
 {
   free(ptr);
 }
@@ -66,7 +73,7 @@ void volk_free(void *ptr)
 // available on Windows since Visual C++ 2005
 #elif _MSC_VER >= 1400
 
-void *volk_malloc(size_t size, size_t alignment)
+static void *system_malloc(size_t size, size_t alignment)
 {
   void *ptr = _aligned_malloc(size, alignment);
   if(ptr == NULL) {
@@ -75,7 +82,7 @@ void *volk_malloc(size_t size, size_t alignment)
   return ptr;
 }
 
-void volk_free(void *ptr)
+static void system_free(void *ptr)
 {
   _aligned_free(ptr);
 }
@@ -88,8 +95,8 @@ struct block_info
   void *real;
 };
 
-void *
-volk_malloc(size_t size, size_t alignment)
+static void *
+system_malloc(size_t size, size_t alignment)
 {
   void *real, *user;
   struct block_info *info;
@@ -112,8 +119,8 @@ volk_malloc(size_t size, size_t alignment)
   return user;
 }
 
-void
-volk_free(void *ptr)
+static void
+system_free(void *ptr)
 {
   struct block_info *info;
 
@@ -127,3 +134,694 @@ volk_free(void *ptr)
 #endif // _POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600 || HAVE_POSIX_MEMALIGN
 
 //#endif // _ISOC11_SOURCE
+
+/*
+ * Optional size-class pool in front of the system allocator, for callers
+ * that allocate and free buffers at block rate. Blocks are rounded up to
+ * a power of two between 64 bytes and 1 MiB and recycled instead of
+ * freed: each thread keeps a short cache per class and trades batches of
+ * blocks with a global lock-free stack when that cache runs full or dry,
+ * or when the thread exits.
+ * Larger or more strictly aligned requests go to the system allocator.
+ *
+ * Built in by default where the compiler has atomics and thread locals.
+ * ENABLE_MALLOC_POOL (VOLK_MALLOC_POOL_DEFAULT) turns it on, and the
+ * VOLK_MALLOC_POOL environment variable (0 or 1) overrides that. The
+ * choice is made at the first call and holds for the whole process.
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define POOL_MIN_SHIFT 6
+#define POOL_N_CLASSES 15 // 64 bytes to 1 MiB
+#define POOL_LARGE POOL_N_CLASSES
+#define POOL_CACHE_BYTES (256 * 1024)
+
+// sits right before every pointer handed out in pool mode
+struct pool_header
+{
+  void *real; // what the system allocator returned
+  size_t size_class; // POOL_LARGE for blocks that bypass the pool
+};
+
+// free blocks link through their first two words
+struct pool_link
+{
+  struct pool_link *next; // the next block of the batch
+  struct pool_link *next_batch;
+};
+
+struct pool_cache
+{
+  struct pool_link *head[POOL_N_CLASSES];
+  unsigned int count[POOL_N_CLASSES];
+  int exit_hook; // set once the thread exit hook has this cache
+};
+
+static int pool_mode = -1; // -1 until the first call decides
+static size_t pool_alignment;
+static struct pool_link *pool_batches[POOL_N_CLASSES];
+static __VOLK_THREAD_LOCAL struct pool_cache pool_cache;
+
+static int pool_enabled(void)
+{
+  int mode = volk_atomic_load_acquire(&pool_mode);
+  if (mode >= 0)
+    return mode;
+
+#if defined(VOLK_MALLOC_POOL_DEFAULT)
+  mode = 1;
+#else
+  mode = 0;
+#endif
+  const char *env = getenv("VOLK_MALLOC_POOL");
+  if (env != NULL && env[0] != '\0')
+    mode = strcmp(env, "0") != 0;
+
+  // racing first calls all compute the same values
+  size_t alignment = volk_get_alignment();
+  if (alignment < sizeof(struct pool_header))
+    alignment = sizeof(struct pool_header);
+  volk_atomic_store_relaxed(&pool_alignment, alignment);
+  volk_atomic_store_release(&pool_mode, mode);
+  return mode;
+}
+
+// blocks a thread caches per class before it hands a batch back
+static unsigned int pool_cache_limit(size_t size_class)
+{
+  const size_t bytes = (size_t)1 << (size_class + POOL_MIN_SHIFT);
+  return bytes * 4 >= POOL_CACHE_BYTES ? 4 : (unsigned int)(POOL_CACHE_BYTES / bytes);
+}
+
+static void pool_push_batches(size_t size_class, struct pool_link *first, struct pool_link *last)
+{
+  struct pool_link *head = volk_atomic_load_relaxed(&pool_batches[size_class]);
+  do {
+    last->next_batch = head;
+  } while (!volk_atomic_cas(&pool_batches[size_class], &head, first));
+}
+
+#if defined(HAVE_PTHREAD)
+#include <pthread.h>
+
+static pthread_key_t pool_exit_key;
+static pthread_once_t pool_exit_once = PTHREAD_ONCE_INIT;
+static int pool_exit_key_ok;
+
+// an exiting thread hands each class of its cache back as one batch
+static void pool_thread_exit(void *arg)
+{
+  struct pool_cache *cache = (struct pool_cache *)arg;
+  cache->exit_hook = 0;
+  for (size_t size_class = 0; size_class < POOL_N_CLASSES; size_class++) {
+    struct pool_link *batch = cache->head[size_class];
+    if (batch == NULL)
+      continue;
+    cache->head[size_class] = NULL;
+    cache->count[size_class] = 0;
+    pool_push_batches(size_class, batch, batch);
+  }
+}
+
+static void pool_exit_key_create(void)
+{
+  pool_exit_key_ok = pthread_key_create(&pool_exit_key, pool_thread_exit) == 0;
+}
+#endif
+
+// called before a block goes into the thread cache, so it is not lost at thread exit
+static void pool_hook_thread_exit(void)
+{
+#if defined(HAVE_PTHREAD)
+  if (pool_cache.exit_hook)
+    return;
+  pthread_once(&pool_exit_once, pool_exit_key_create);
+  if (pool_exit_key_ok && pthread_setspecific(pool_exit_key, &pool_cache) == 0)
+    pool_cache.exit_hook = 1;
+#endif
+}
+
+// takes one batch off the global stack into the thread cache
+static void pool_refill(size_t size_class)
+{
+  // detach the whole stack, so no other thread can pop under us
+  struct pool_link *batches = volk_atomic_load_relaxed(&pool_batches[size_class]);
+  while (batches != NULL &&
+         !volk_atomic_cas(&pool_batches[size_class], &batches, (struct pool_link *)NULL));
+  if (batches == NULL)
+    return;
+
+  pool_hook_thread_exit();
+  struct pool_link *rest = batches->next_batch;
+  if (rest != NULL) {
+    struct pool_link *last = rest;
+    while (last->next_batch != NULL)
+      last = last->next_batch;
+    pool_push_batches(size_class, rest, last);
+  }
+
+  unsigned int count = 0;
+  struct pool_link *block = batches;
+  while (block->next != NULL) {
+    block = block->next;
+    count++;
+  }
+  block->next = pool_cache.head[size_class];
+  pool_cache.head[size_class] = batches;
+  pool_cache.count[size_class] += count + 1;
+}
+
+static void *pool_wrap(void *real, size_t offset, size_t size_class)
+{
+  char *user = (char *)real + offset;
+  struct pool_header *header = (struct pool_header *)user - 1;
+  header->real = real;
+  header->size_class = size_class;
+  return user;
+}
+
+static void *pool_malloc(size_t size, size_t alignment)
+{
+  const size_t block_alignment = volk_atomic_load_relaxed(&pool_alignment);
+
+  if (alignment > block_alignment || size > ((size_t)1 << (POOL_N_CLASSES - 1 + POOL_MIN_SHIFT))) {
+    if (alignment < sizeof(struct pool_header))
+      alignment = sizeof(struct pool_header);
+    void *real = system_malloc(size + alignment, alignment);
+    return real != NULL ? pool_wrap(real, alignment, POOL_LARGE) : NULL;
+  }
+
+  size_t size_class = 0;
+  while (((size_t)1 << (size_class + POOL_MIN_SHIFT)) < size)
+    size_class++;
+
+  if (pool_cache.head[size_class] == NULL)
+    pool_refill(size_class);
+  struct pool_link *block = pool_cache.head[size_class];
+  if (block != NULL) {
+    pool_cache.head[size_class] = block->next;
+    pool_cache.count[size_class]--;
+    return block;
+  }
+
+  const size_t bytes = (size_t)1 << (size_class + POOL_MIN_SHIFT);
+  void *real = system_malloc(bytes + block_alignment, block_alignment);
+  return real != NULL ? pool_wrap(real, block_alignment, size_class) : NULL;
+}
+
+static void pool_free(void *ptr)
+{
+  struct pool_header *header = (struct pool_header *)ptr - 1;
+  const size_t size_class = header->size_class;
+  if (size_class == POOL_LARGE) {
+    system_free(header->real);
+    return;
+  }
+
+  pool_hook_thread_exit();
+  struct pool_link *block = (struct pool_link *)ptr;
+  block->next = pool_cache.head[size_class];
+  pool_cache.head[size_class] = block;
+  const unsigned int limit = pool_cache_limit(size_class);
+  if (++pool_cache.count[size_class] < limit)
+    return;
+
+  // hand the older half to the other threads as one batch
+  struct pool_link *last = block;
+  for (unsigned int i = 1; i < limit / 2; i++)
+    last = last->next;
+  struct pool_link *batch = last->next;
+  last->next = NULL;
+  pool_cache.count[size_class] = limit / 2;
+  pool_push_batches(size_class, batch, batch);
+}
+
+#else
+
+static int pool_enabled(void) { return 0; }
+static void *pool_malloc(size_t size, size_t alignment) { return system_malloc(size, alignment); }
+static void pool_free(void *ptr) { system_free(ptr); }
+
+#endif // defined(__GNUC__) || defined(__clang__)
+
+void *volk_malloc(size_t size, size_t alignment)
+{
+  if (pool_enabled())
+    return pool_malloc(size, alignment);
+  return system_malloc(size, alignment);
+}
+
+void volk_free(void *ptr)
+{
+  if (ptr == NULL)
+    return;
+  if (pool_enabled())
+    pool_free(ptr);
+  else
+    system_free(ptr);
+}
+
+int volk_malloc_is_pooled(void)
+{
+  return pool_enabled();
+}
+
+/*
+ * volk_malloc_ex: large buffers straight from mmap on Linux, with huge
+ * pages, a preferred NUMA node and pre-faulting as asked, and from the
+ * system allocator elsewhere or when everything else failed. How each
+ * buffer was made is kept in a small table keyed by its address, not in
+ * the mapping, so a buffer of N huge pages takes N pages and starts on a
+ * page boundary.
+ */
+
+#define EX_ALIGNMENT 64
+#define EX_N_BUCKETS 64
+
+struct ex_header
+{
+  struct ex_header *next; // in the same bucket
+  void *base; // what volk_malloc_ex returned, and what to munmap or free
+  size_t length; // the mapping length, 0 for the system allocator
+  unsigned int flags; // the flags that took effect
+};
+
+// few and long-lived buffers, so one lock for the table is enough
+static struct ex_header *ex_table[EX_N_BUCKETS];
+static int ex_table_locked;
+
+static void ex_lock(void)
+{
+  int unlocked = 0;
+  while (!volk_atomic_cas(&ex_table_locked, &unlocked, 1))
+    unlocked = 0;
+}
+
+static void ex_unlock(void)
+{
+  volk_atomic_store_release(&ex_table_locked, 0);
+}
+
+static struct ex_header **ex_bucket(const void *ptr)
+{
+  const uintptr_t key = (uintptr_t)ptr / EX_ALIGNMENT;
+  return &ex_table[(key ^ (key >> 6) ^ (key >> 12) ^ (key >> 18)) % EX_N_BUCKETS];
+}
+
+// records the buffer; returns base, or NULL when the record could not be made
+static void *ex_wrap(void *base, size_t length, unsigned int flags)
+{
+  struct ex_header *header = (struct ex_header *)malloc(sizeof(*header));
+  if (header == NULL)
+    return NULL;
+  header->base = base;
+  header->length = length;
+  header->flags = flags;
+  ex_lock();
+  struct ex_header **bucket = ex_bucket(base);
+  header->next = *bucket;
+  *bucket = header;
+  ex_unlock();
+  return base;
+}
+
+// takes the record of ptr out of the table, or reads it when keep is set
+static int ex_lookup(const void *ptr, struct ex_header *out, int keep)
+{
+  int found = 0;
+  ex_lock();
+  for (struct ex_header **link = ex_bucket(ptr); *link != NULL; link = &(*link)->next) {
+    struct ex_header *header = *link;
+    if (header->base != ptr)
+      continue;
+    *out = *header;
+    if (!keep) {
+      *link = header->next;
+      free(header);
+    }
+    found = 1;
+    break;
+  }
+  ex_unlock();
+  return found;
+}
+
+// records a buffer from the system allocator, freeing it if that fails
+static void *ex_wrap_system(void *base, unsigned int flags)
+{
+  if (base == NULL || ex_wrap(base, 0, flags) != NULL)
+    return base;
+  system_free(base);
+  return NULL;
+}
+
+#if defined(__linux__)
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define EX_MPOL_PREFERRED 1
+
+static size_t ex_round_up(size_t size, size_t unit)
+{
+  return (size + unit - 1) / unit * unit;
+}
+
+// the default hugetlbfs page size, from /proc/meminfo
+static size_t ex_huge_page_size(void)
+{
+  size_t kib = 2048;
+  char line[128];
+  FILE *meminfo = fopen("/proc/meminfo", "r");
+  if (meminfo == NULL)
+    return kib * 1024;
+  while (fgets(line, sizeof(line), meminfo) != NULL) {
+    unsigned long value;
+    if (sscanf(line, "Hugepagesize: %lu kB", &value) == 1) {
+      kib = value;
+      break;
+    }
+  }
+  fclose(meminfo);
+  return kib * 1024;
+}
+
+static void *ex_map_hugetlb(size_t length, int populate)
+{
+  void *base = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (populate ? MAP_POPULATE : 0), -1, 0);
+  return base == MAP_FAILED ? NULL : base;
+}
+
+// maps length bytes aligned to alignment, trimming the excess
+static void *ex_map_aligned(size_t length, size_t alignment)
+{
+  char *raw = (char *)mmap(NULL, length + alignment, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if ((void *)raw == MAP_FAILED)
+    return NULL;
+  char *base = (char *)(((uintptr_t)raw + alignment - 1) & ~(uintptr_t)(alignment - 1));
+  if (base != raw)
+    munmap(raw, base - raw);
+  if (base + length != raw + length + alignment)
+    munmap(base + length, (raw + length + alignment) - (base + length));
+  return base;
+}
+
+// prefer node for the pages of the range; a hint, the kernel may not know NUMA
+static int ex_prefer_node(void *base, size_t length, unsigned int node)
+{
+  unsigned long mask[16] = {0};
+  const unsigned int bits = (unsigned int)(sizeof(unsigned long) * 8);
+  if (node >= bits * 16)
+    return 0;
+  mask[node / bits] = 1UL << (node % bits);
+  return syscall(SYS_mbind, base, length, EX_MPOL_PREFERRED, mask, (unsigned long)(bits * 16), 0) == 0;
+}
+
+void *volk_malloc_ex(size_t size, unsigned int flags)
+{
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  const int has_node = (flags & VOLK_MALLOC_NODE_MASK) != 0;
+  const unsigned int node = VOLK_MALLOC_NODE_OF(flags);
+  const int prefault = (flags & VOLK_MALLOC_PREFAULT) != 0;
+  unsigned int applied = 0;
+  size_t length = 0;
+  void *base = NULL;
+
+  if (size == 0)
+    size = 1; // mmap takes no empty mappings
+  if (flags & VOLK_MALLOC_HUGE_TLB) {
+    // populating here would place the pages before the node is set
+    length = ex_round_up(size, ex_huge_page_size());
+    base = ex_map_hugetlb(length, prefault && !has_node);
+    if (base != NULL)
+      applied |= VOLK_MALLOC_HUGE_TLB;
+    else if (flags & VOLK_MALLOC_NO_FALLBACK)
+      return NULL;
+  }
+
+  if (base == NULL) {
+    const int huge = (flags & (VOLK_MALLOC_HUGE_PAGES | VOLK_MALLOC_HUGE_TLB)) != 0;
+    const size_t huge_size = (size_t)2 * 1024 * 1024; // the transparent huge page size
+    length = ex_round_up(size, huge ? huge_size : page_size);
+    base = ex_map_aligned(length, huge ? huge_size : page_size);
+    if (base == NULL) {
+      if (flags & VOLK_MALLOC_NO_FALLBACK)
+        return NULL;
+      return ex_wrap_system(system_malloc(size, EX_ALIGNMENT), 0);
+    }
+#if defined(MADV_HUGEPAGE)
+    if (huge && madvise(base, length, MADV_HUGEPAGE) == 0)
+      applied |= VOLK_MALLOC_HUGE_PAGES;
+#endif
+    if (huge && !(applied & VOLK_MALLOC_HUGE_PAGES) && (flags & VOLK_MALLOC_NO_FALLBACK)) {
+      munmap(base, length);
+      return NULL;
+    }
+  }
+
+  if (has_node && ex_prefer_node(base, length, node))
+    applied |= flags & VOLK_MALLOC_NODE_MASK;
+
+  if (prefault) {
+    if (!(applied & VOLK_MALLOC_HUGE_TLB) || has_node) {
+      const size_t step = (applied & VOLK_MALLOC_HUGE_TLB) ? ex_huge_page_size() : page_size;
+      for (size_t offset = 0; offset < length; offset += step)
+        ((volatile char *)base)[offset] = 0;
+    }
+    applied |= VOLK_MALLOC_PREFAULT;
+  }
+
+  if (ex_wrap(base, length, applied) == NULL) {
+    munmap(base, length);
+    return NULL;
+  }
+  return base;
+}
+
+static void ex_unmap(const struct ex_header *header)
+{
+  if (header->length != 0)
+    munmap(header->base, header->length);
+  else
+    system_free(header->base);
+}
+
+#else // defined(__linux__)
+
+void *volk_malloc_ex(size_t size, unsigned int flags)
+{
+  if (flags & (VOLK_MALLOC_HUGE_PAGES | VOLK_MALLOC_HUGE_TLB | VOLK_MALLOC_NODE_MASK)) {
+    if (flags & VOLK_MALLOC_NO_FALLBACK)
+      return NULL;
+  }
+  char *base = (char *)system_malloc(size ? size : 1, EX_ALIGNMENT);
+  if (base != NULL && (flags & VOLK_MALLOC_PREFAULT))
+    memset(base, 0, size);
+  return ex_wrap_system(base, flags & VOLK_MALLOC_PREFAULT);
+}
+
+static void ex_unmap(const struct ex_header *header)
+{
+  system_free(header->base);
+}
+
+#endif // defined(__linux__)
+
+void volk_free_ex(void *ptr)
+{
+  struct ex_header header;
+  if (ptr == NULL)
+    return;
+  if (!ex_lookup(ptr, &header, 0)) {
+    fprintf(stderr, "VOLK: volk_free_ex called on memory not from volk_malloc_ex\n");
+    return;
+  }
+  ex_unmap(&header);
+}
+
+unsigned int volk_malloc_ex_flags(const void *ptr)
+{
+  struct ex_header header;
+  return ex_lookup(ptr, &header, 1) ? header.flags : 0;
+}
+
+/*
+ * Per-thread scratch arena. Buffers are carved with a bump pointer from
+ * a chain of chunks. A request that does not fit the current chunk moves
+ * on to the next one, and a new chunk at least twice the last is only
+ * added at the end of the chain, so chunks are kept and reused while
+ * buffers are held. Once everything is released a chain of several
+ * chunks is merged into one of their total size, so a loop that asks
+ * for the same sizes stops allocating after its first iteration.
+ *
+ * A mark is a position along the whole chain: each chunk starts where
+ * the previous one ends.
+ */
+
+#define SCRATCH_BLOCK_ALIGNMENT 64
+#define SCRATCH_MIN_CHUNK 4096
+
+struct scratch_chunk
+{
+  struct scratch_chunk *next;
+  size_t start; // the position of the first byte of this chunk
+  size_t size;
+};
+
+struct scratch_arena
+{
+  struct scratch_chunk *first;
+  struct scratch_chunk *current; // the chunk that holds position used
+  size_t used;
+  int exit_hook; // set once the thread exit hook has this arena
+};
+
+static __VOLK_THREAD_LOCAL struct scratch_arena scratch;
+
+// the data follows the header in the same block, on its own alignment
+static char *scratch_data(struct scratch_chunk *chunk)
+{
+  return (char *)chunk + SCRATCH_BLOCK_ALIGNMENT;
+}
+
+static void scratch_free_chunks(struct scratch_arena *arena)
+{
+  struct scratch_chunk *chunk = arena->first;
+  while (chunk != NULL) {
+    struct scratch_chunk *next = chunk->next;
+    volk_free(chunk);
+    chunk = next;
+  }
+  arena->first = NULL;
+  arena->current = NULL;
+  arena->used = 0;
+}
+
+#if defined(HAVE_PTHREAD)
+static pthread_key_t scratch_exit_key;
+static pthread_once_t scratch_exit_once = PTHREAD_ONCE_INIT;
+static int scratch_exit_key_ok;
+
+// an exiting thread frees its arena; nothing in it can be held any more
+static void scratch_thread_exit(void *arg)
+{
+  struct scratch_arena *arena = (struct scratch_arena *)arg;
+  arena->exit_hook = 0;
+  scratch_free_chunks(arena);
+}
+
+static void scratch_exit_key_create(void)
+{
+  scratch_exit_key_ok = pthread_key_create(&scratch_exit_key, scratch_thread_exit) == 0;
+}
+#endif
+
+// called before the first chunk of a thread is allocated, so it is freed at thread exit
+static void scratch_hook_thread_exit(void)
+{
+#if defined(HAVE_PTHREAD)
+  if (scratch.exit_hook)
+    return;
+  pthread_once(&scratch_exit_once, scratch_exit_key_create);
+  if (scratch_exit_key_ok && pthread_setspecific(scratch_exit_key, &scratch) == 0)
+    scratch.exit_hook = 1;
+#endif
+}
+
+static struct scratch_chunk *scratch_new_chunk(size_t start, size_t size)
+{
+  scratch_hook_thread_exit();
+  struct scratch_chunk *chunk =
+      (struct scratch_chunk *)volk_malloc(SCRATCH_BLOCK_ALIGNMENT + size, SCRATCH_BLOCK_ALIGNMENT);
+  if (chunk == NULL)
+    return NULL;
+  chunk->next = NULL;
+  chunk->start = start;
+  chunk->size = size;
+  return chunk;
+}
+
+// carves size bytes from chunk at position from, or returns NULL if they do not fit
+static void *scratch_carve(struct scratch_chunk *chunk, size_t from, size_t size, size_t alignment)
+{
+  const size_t offset = from - chunk->start;
+  const uintptr_t start = (uintptr_t)scratch_data(chunk) + offset;
+  const size_t pad = (size_t)(-start & (alignment - 1));
+  if (pad > chunk->size - offset || size > chunk->size - offset - pad)
+    return NULL;
+  scratch.current = chunk;
+  scratch.used = from + pad + size;
+  return (void *)(start + pad);
+}
+
+void *volk_scratch_get(size_t size, size_t alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    return NULL;
+
+  struct scratch_chunk *chunk = scratch.current;
+  if (chunk != NULL) {
+    void *ptr = scratch_carve(chunk, scratch.used, size, alignment);
+    if (ptr != NULL)
+      return ptr;
+    // the chunks past the current one are free, skip to the first that fits
+    while (chunk->next != NULL) {
+      chunk = chunk->next;
+      ptr = scratch_carve(chunk, chunk->start, size, alignment);
+      if (ptr != NULL)
+        return ptr;
+    }
+  }
+
+  size_t chunk_size = size + alignment - 1;
+  if (chunk_size < size)
+    return NULL;
+  if (chunk != NULL && chunk_size < 2 * chunk->size)
+    chunk_size = 2 * chunk->size;
+  if (chunk_size < SCRATCH_MIN_CHUNK)
+    chunk_size = SCRATCH_MIN_CHUNK;
+  struct scratch_chunk *added =
+      scratch_new_chunk(chunk != NULL ? chunk->start + chunk->size : 0, chunk_size);
+  if (added == NULL)
+    return NULL;
+  if (chunk != NULL)
+    chunk->next = added;
+  else
+    scratch.first = added;
+  return scratch_carve(added, added->start, size, alignment);
+}
+
+size_t volk_scratch_mark(void)
+{
+  return scratch.used;
+}
+
+void volk_scratch_release(size_t mark)
+{
+  if (mark > scratch.used || scratch.first == NULL)
+    return;
+  struct scratch_chunk *chunk = scratch.first;
+  while (mark > chunk->start + chunk->size)
+    chunk = chunk->next;
+  scratch.current = chunk;
+  scratch.used = mark;
+
+  if (mark == 0 && scratch.first->next != NULL) {
+    struct scratch_chunk *last = scratch.first;
+    while (last->next != NULL)
+      last = last->next;
+    const size_t total = last->start + last->size;
+    scratch_free_chunks(&scratch);
+    scratch.first = scratch_new_chunk(0, total);
+    scratch.current = scratch.first;
+  }
+}
+
+void volk_scratch_free(void)
+{
+  scratch_free_chunks(&scratch);
+}
@@ -30,28 +30,95 @@ void volk_get_config_path(char *path)
     strcat(path, suffix);
 }
 
+size_t volk_load_preferences_ex(volk_arch_pref_ex_t **prefs_res)
+{
+    char path[512];
+    size_t n_arch_prefs;
+
+    *prefs_res = NULL;
+    //get the config path
+    volk_get_config_path(path);
+    if (!path[0]) return 0; //no prefs found
+    n_arch_prefs = volk_load_preferences_from(path, prefs_res);
+    return n_arch_prefs == VOLK_PREFS_UNREADABLE? 0 : n_arch_prefs; //a missing default config is fine
+}
+
 size_t volk_load_preferences(volk_arch_pref_t **prefs_res)
+{
+    volk_arch_pref_ex_t *prefs_ex;
+    volk_arch_pref_t *prefs = NULL;
+    size_t n_arch_prefs = volk_load_preferences_ex(&prefs_ex);
+    size_t i;
+
+    if(n_arch_prefs > 0) {
+        prefs = (volk_arch_pref_t *) malloc(n_arch_prefs * sizeof(*prefs));
+        if(!prefs) n_arch_prefs = 0;
+    }
+    for(i = 0; i < n_arch_prefs; i++) {
+        memcpy(prefs[i].name, prefs_ex[i].name, sizeof(prefs[i].name));
+        memcpy(prefs[i].impl_a, prefs_ex[i].impl_a, sizeof(prefs[i].impl_a));
+        memcpy(prefs[i].impl_u, prefs_ex[i].impl_u, sizeof(prefs[i].impl_u));
+    }
+    free(prefs_ex);
+    *prefs_res = prefs;
+    return n_arch_prefs;
+}
+
+//reads the optional "max_len impl_a impl_u" triples after the default impls;
+//parsing stops at the first malformed or out of order triple
+static void volk_parse_len_buckets(const char *rest, volk_arch_pref_ex_t *p)
+{
+    int consumed;
+    p->n_buckets = 0;
+    while(p->n_buckets < VOLK_MAX_LEN_BUCKETS) {
+        volk_arch_pref_bucket_t *bucket = p->buckets + p->n_buckets;
+        if(sscanf(rest, "%u %127s %127s%n", &bucket->max_len, bucket->impl_a, bucket->impl_u, &consumed) != 3)
+            break;
+        if(bucket->max_len == 0 || (p->n_buckets > 0 && bucket->max_len <= bucket[-1].max_len))
+            break;
+        p->n_buckets++;
+        rest += consumed;
+    }
+}
+
+size_t volk_load_preferences_from(const char *path, volk_arch_pref_ex_t **prefs_res)
 {
     FILE *config_file;
-    char path[512], line[512];
+    char line[512];
     size_t n_arch_prefs = 0;
-    volk_arch_pref_t *prefs = NULL;
+    size_t n_alloc = 0;
+    volk_arch_pref_ex_t *prefs = NULL;
+    volk_arch_pref_ex_t p;
+    int offset;
 
-    //get the config path
-    volk_get_config_path(path);
-    if (!path[0]) return n_arch_prefs; //no prefs found
     config_file = fopen(path, "r");
-    if(!config_file) return n_arch_prefs; //no prefs found
+    if(!config_file) {
+        *prefs_res = NULL;
+        return VOLK_PREFS_UNREADABLE;
+    }
 
     //reset the file pointer and write the prefs into volk_arch_prefs
     while(fgets(line, sizeof(line), config_file) != NULL)
     {
-        prefs = (volk_arch_pref_t *) realloc(prefs, (n_arch_prefs+1) * sizeof(*prefs));
-        volk_arch_pref_t *p = prefs + n_arch_prefs;
-        if(sscanf(line, "%s %s %s", p->name, p->impl_a, p->impl_u) == 3 && !strncmp(p->name, "volk_", 5))
-        {
-            n_arch_prefs++;
+        //drop the rest of an overlong line rather than parsing it as a new one
+        if(strchr(line, '\n') == NULL) {
+            int c;
+            while((c = fgetc(config_file)) != '\n' && c != EOF);
+        }
+
+        //the field widths match the sizes in volk_arch_pref_ex_t
+        if(sscanf(line, "%127s %127s %127s%n", p.name, p.impl_a, p.impl_u, &offset) != 3 || strncmp(p.name, "volk_", 5))
+            continue;
+        volk_parse_len_buckets(line + offset, &p);
+
+        if(n_arch_prefs == n_alloc) {
+            volk_arch_pref_ex_t *grown;
+            n_alloc = n_alloc? 2*n_alloc : 128;
+            grown = (volk_arch_pref_ex_t *) realloc(prefs, n_alloc * sizeof(*prefs));
+            if(!grown) break;
+            prefs = grown;
         }
+        prefs[n_arch_prefs++] = p;
     }
     fclose(config_file);
     *prefs_res = prefs;
@@ -20,11 +20,118 @@
  */
 
 #include <volk_rank_archs.h>
+#include "volk_atomic.h"
 #include <volk/volk_prefs.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+typedef struct
+{
+    volk_arch_pref_ex_t *prefs;
+    size_t n_prefs;
+    size_t *slots;     //open addressed index into prefs, 0 marks an empty slot
+    size_t slot_mask;  //number of slots - 1, a power of two at least 2*n_prefs
+    bool generic_only; //VOLK_GENERIC was set when the prefs were loaded
+} volk_arch_prefs_list_t;
+
+static volk_arch_prefs_list_t *loaded_arch_prefs = NULL;
+
+//FNV-1a; kernel names are short and share long prefixes
+static size_t volk_hash_name(const char *name)
+{
+    size_t hash = 2166136261u;
+    while(*name) {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void volk_index_arch_prefs(volk_arch_prefs_list_t *list)
+{
+    size_t i, n_slots = 16;
+    while(n_slots < 2*list->n_prefs) n_slots *= 2;
+    list->slots = (size_t *) calloc(n_slots, sizeof(size_t));
+    list->slot_mask = n_slots - 1;
+    if(!list->slots) return;
+
+    for(i = 0; i < list->n_prefs; i++) {
+        size_t slot = volk_hash_name(list->prefs[i].name) & list->slot_mask;
+        while(list->slots[slot] != 0) {
+            //the first line for a kernel wins, as it did with the linear scan
+            if(!strcmp(list->prefs[list->slots[slot]-1].name, list->prefs[i].name)) break;
+            slot = (slot + 1) & list->slot_mask;
+        }
+        if(list->slots[slot] == 0) list->slots[slot] = i+1;
+    }
+}
+
+static const volk_arch_pref_ex_t *volk_find_arch_pref(const volk_arch_prefs_list_t *list, const char *kern_name)
+{
+    size_t slot, i;
+    if(!list->slots) { //no memory for the index; fall back to a scan
+        for(i = 0; i < list->n_prefs; i++) {
+            if(!strcmp(list->prefs[i].name, kern_name)) return list->prefs + i;
+        }
+        return NULL;
+    }
+    slot = volk_hash_name(kern_name) & list->slot_mask;
+    while(list->slots[slot] != 0) {
+        const volk_arch_pref_ex_t *pref = list->prefs + list->slots[slot]-1;
+        if(!strcmp(pref->name, kern_name)) return pref;
+        slot = (slot + 1) & list->slot_mask;
+    }
+    return NULL;
+}
+
+//unreadable is set when config_path could not be opened
+static volk_arch_prefs_list_t *volk_new_arch_prefs(const char *config_path, bool *unreadable)
+{
+    volk_arch_prefs_list_t *list = (volk_arch_prefs_list_t *) malloc(sizeof(*list));
+    list->prefs = NULL;
+    list->n_prefs = (config_path == NULL)?
+        volk_load_preferences_ex(&list->prefs) :
+        volk_load_preferences_from(config_path, &list->prefs);
+    *unreadable = list->n_prefs == VOLK_PREFS_UNREADABLE;
+    if(*unreadable) list->n_prefs = 0;
+    volk_index_arch_prefs(list);
+    // If we've defined VOLK_GENERIC to be anything, always return the
+    // 'generic' kernel. Used in GR's QA code.
+    list->generic_only = getenv("VOLK_GENERIC") != NULL;
+    return list;
+}
+
+/* Loads the preferences file once. Threads ranking their first kernels
+ * at the same time may each read the file; the first list published
+ * wins and the others are dropped.
+ */
+static const volk_arch_prefs_list_t *volk_get_arch_prefs(void)
+{
+    volk_arch_prefs_list_t *list = volk_atomic_load_acquire(&loaded_arch_prefs);
+    volk_arch_prefs_list_t *expected = NULL;
+    bool unreadable;
+    if(list != NULL) return list;
+
+    list = volk_new_arch_prefs(NULL, &unreadable);
+    if(!volk_atomic_cas(&loaded_arch_prefs, &expected, list)) {
+        free(list->prefs);
+        free(list->slots);
+        free(list);
+        list = expected;
+    }
+    return list;
+}
+
+size_t volk_rank_archs_load_prefs(const char *config_path)
+{
+    bool unreadable;
+    volk_arch_prefs_list_t *list = volk_new_arch_prefs(config_path, &unreadable);
+    //a replaced list is never freed: rankings in other threads may still read it
+    volk_atomic_store_release(&loaded_arch_prefs, list);
+    return unreadable? VOLK_PREFS_UNREADABLE : list->n_prefs;
+}
+
 int volk_get_index(
     const char *impl_names[], //list of implementations by name
     const size_t n_impls,     //number of implementations available
@@ -42,6 +149,32 @@ int volk_get_index(
     return volk_get_index(impl_names, n_impls, "generic"); //but we'll fake it for now
 }
 
+size_t volk_rank_archs_buckets(
+    const char *kern_name,    //name of the kernel to rank
+    const char *impl_names[], //list of implementations by name
+    size_t n_impls,           //number of implementations available
+    unsigned int *max_lens,   //upper bound (exclusive) of num_points per bucket
+    int *index_a,             //aligned implementation per bucket
+    int *index_u              //unaligned implementation per bucket
+)
+{
+    size_t i;
+    const volk_arch_prefs_list_t *arch_prefs = volk_get_arch_prefs();
+    const volk_arch_pref_ex_t *pref;
+
+    if(arch_prefs->generic_only) return 0;
+
+    pref = volk_find_arch_pref(arch_prefs, kern_name);
+    if(pref == NULL) return 0;
+
+    for(i = 0; i < pref->n_buckets; i++) {
+        max_lens[i] = pref->buckets[i].max_len;
+        index_a[i] = volk_get_index(impl_names, n_impls, pref->buckets[i].impl_a);
+        index_u[i] = volk_get_index(impl_names, n_impls, pref->buckets[i].impl_u);
+    }
+    return pref->n_buckets;
+}
+
 int volk_rank_archs(
     const char *kern_name,    //name of the kernel to rank
     const char *impl_names[], //list of implementations by name
@@ -52,29 +185,19 @@ int volk_rank_archs(
 )
 {
     size_t i;
-    static volk_arch_pref_t *volk_arch_prefs;
-    static size_t n_arch_prefs = 0;
-    static int prefs_loaded = 0;
-    if(!prefs_loaded) {
-        n_arch_prefs = volk_load_preferences(&volk_arch_prefs);
-        prefs_loaded = 1;
-    }
+    const volk_arch_prefs_list_t *arch_prefs = volk_get_arch_prefs();
+    const volk_arch_pref_ex_t *pref;
 
-    // If we've defined VOLK_GENERIC to be anything, always return the
-    // 'generic' kernel. Used in GR's QA code.
-    char *gen_env = getenv("VOLK_GENERIC");
-    if(gen_env) {
+    if(arch_prefs->generic_only) {
       return volk_get_index(impl_names, n_impls, "generic");
     }
 
     //now look for the function name in the prefs list
-    for(i = 0; i < n_arch_prefs; i++)
+    pref = volk_find_arch_pref(arch_prefs, kern_name);
+    if(pref != NULL) //found it
     {
-        if(!strncmp(kern_name, volk_arch_prefs[i].name, sizeof(volk_arch_prefs[i].name))) //found it
-        {
-            const char *impl_name = align? volk_arch_prefs[i].impl_a : volk_arch_prefs[i].impl_u;
-            return volk_get_index(impl_names, n_impls, impl_name);
-        }
+        const char *impl_name = align? pref->impl_a : pref->impl_u;
+        return volk_get_index(impl_names, n_impls, impl_name);
     }
 
     //return the best index with the largest deps
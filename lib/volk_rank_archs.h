@@ -44,6 +44,28 @@ int volk_rank_archs(
     const bool align          //if false, filter aligned implementations
 );
 
+/*!
+ * Looks up the length buckets configured for kern_name. Fills max_lens,
+ * index_a and index_u (each VOLK_MAX_LEN_BUCKETS long) in ascending
+ * max_len and returns the number of buckets; 0 when the kernel has none.
+ */
+size_t volk_rank_archs_buckets(
+    const char *kern_name,    //name of the kernel to rank
+    const char *impl_names[], //list of implementations by name
+    size_t n_impls,           //number of implementations available
+    unsigned int *max_lens,   //upper bound (exclusive) of num_points per bucket
+    int *index_a,             //aligned implementation per bucket
+    int *index_u              //unaligned implementation per bucket
+);
+
+/*!
+ * (Re)load the preferences used by volk_rank_archs from config_path, or
+ * from the default volk_config location when config_path is NULL.
+ * Returns the number of kernel preferences found, or
+ * VOLK_PREFS_UNREADABLE when config_path cannot be opened.
+ */
+size_t volk_rank_archs_load_prefs(const char *config_path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,144 @@
+/* -*- c -*- */
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Double mapped rings: reserve twice the size of address space, then map
+ * the same shared memory object over both halves. On Linux the object is
+ * an anonymous memfd; other POSIX systems use an unlinked shm object.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // memfd_create
+#endif
+
+#include <volk/volk_ringbuf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+// a file descriptor for size bytes of shared memory with no name left behind
+static int ringbuf_open(size_t size)
+{
+  int fd = -1;
+#if defined(__linux__) && defined(SYS_memfd_create)
+  fd = (int)syscall(SYS_memfd_create, "volk_ringbuf", 0);
+#else
+  char name[64];
+  for (unsigned int attempt = 0; fd < 0 && attempt < 16; attempt++) {
+    snprintf(name, sizeof(name), "/volk_ringbuf_%ld_%u_%u",
+             (long)getpid(), (unsigned int)rand(), attempt);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0)
+      shm_unlink(name);
+    else if (errno != EEXIST)
+      break;
+  }
+#endif
+  if (fd < 0)
+    return -1;
+  if (ftruncate(fd, (off_t)size) != 0) {
+    const int err = errno; // reported by the caller, close may overwrite it
+    close(fd);
+    errno = err;
+    return -1;
+  }
+  return fd;
+}
+
+void *volk_ringbuf_alloc(size_t min_size, size_t *size)
+{
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+  // rounding up to a page and reserving both halves must not wrap
+  if (min_size > SIZE_MAX / 2 - page_size) {
+    errno = EINVAL;
+    fprintf(stderr, "VOLK: Ring buffer size %zu is too large\n", min_size);
+    return NULL;
+  }
+
+  const size_t ring_size = (min_size == 0 ? 1 : (min_size + page_size - 1) / page_size) * page_size;
+
+  const int fd = ringbuf_open(ring_size);
+  if (fd < 0) {
+    fprintf(stderr, "VOLK: Error creating ring buffer memory (%s)\n", strerror(errno));
+    return NULL;
+  }
+
+  int err = 0; // the errno of the failed mmap, before munmap and close
+  char *base = (char *)mmap(NULL, 2 * ring_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if ((void *)base == MAP_FAILED) {
+    err = errno;
+  }
+  else {
+    // MAP_FIXED replaces the reservation, so nothing can slip in between
+    if (mmap(base, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        mmap(base + ring_size, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      err = errno;
+      munmap(base, 2 * ring_size);
+      base = (char *)MAP_FAILED;
+    }
+  }
+  close(fd);
+
+  if ((void *)base == MAP_FAILED) {
+    fprintf(stderr, "VOLK: Error mapping ring buffer (%s)\n", strerror(err));
+    return NULL;
+  }
+  if (size != NULL)
+    *size = ring_size;
+  return base;
+}
+
+void volk_ringbuf_free(void *ptr, size_t size)
+{
+  if (ptr != NULL)
+    munmap(ptr, 2 * size);
+}
+
+#else // defined(__unix__) || defined(__APPLE__)
+
+void *volk_ringbuf_alloc(size_t min_size, size_t *size)
+{
+  (void)min_size;
+  (void)size;
+  fprintf(stderr, "VOLK: Ring buffers are not supported on this platform\n");
+  return NULL;
+}
+
+void volk_ringbuf_free(void *ptr, size_t size)
+{
+  (void)ptr;
+  (void)size;
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -24,38 +24,58 @@
 #include <volk/volk_typedefs.h>
 #include <volk/volk_cpu.h>
 #include "volk_rank_archs.h"
+#include "volk_atomic.h"
 #include <volk/volk.h>
+#include <volk/volk_prefs.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
-static size_t __alignment = 0;
-static intptr_t __alignment_mask = 0;
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
-struct volk_machine *get_machine(void)
+/* The selected machine and its alignment mask are published once by
+ * whichever thread gets there first; racing threads select the same machine.
+ * The mask starts out as all ones so that a thread which has not yet seen
+ * the selection treats every buffer as unaligned, which is always safe.
+ */
+static struct volk_machine *__machine = NULL;
+static intptr_t __alignment_mask = ~(intptr_t)0;
+
+//the machine with the most archs that lvarch has all of
+static struct volk_machine *__volk_best_machine(unsigned int lvarch)
 {
   extern struct volk_machine *volk_machines[];
   extern unsigned int n_volk_machines;
-  static struct volk_machine *machine = NULL;
+  unsigned int max_score = 0;
+  unsigned int i;
+  struct volk_machine *max_machine = NULL;
+  for(i=0; i<n_volk_machines; i++) {
+    if(!(volk_machines[i]->caps & (~lvarch))) {
+      if(volk_machines[i]->caps > max_score) {
+        max_score = volk_machines[i]->caps;
+        max_machine = volk_machines[i];
+      }
+    }
+  }
+  return max_machine;
+}
+
+struct volk_machine *get_machine(void)
+{
+  struct volk_machine *machine = volk_atomic_load_acquire(&__machine);
 
   if(machine != NULL)
     return machine;
   else {
-    unsigned int max_score = 0;
-    unsigned int i;
-    struct volk_machine *max_machine = NULL;
-    for(i=0; i<n_volk_machines; i++) {
-      if(!(volk_machines[i]->caps & (~volk_get_lvarch()))) {
-        if(volk_machines[i]->caps > max_score) {
-          max_score = volk_machines[i]->caps;
-          max_machine = volk_machines[i];
-        }
-      }
-    }
-    machine = max_machine;
+    machine = __volk_best_machine(volk_get_lvarch());
     //printf("Using Volk machine: %s\n", machine->name);
-    __alignment = machine->alignment;
-    __alignment_mask = (intptr_t)(__alignment-1);
+    volk_atomic_store_relaxed(&__alignment_mask, (intptr_t)(machine->alignment-1));
+    volk_atomic_store_release(&__machine, machine);
     return machine;
   }
 }
@@ -76,110 +96,517 @@ void volk_list_machines(void)
 
 const char* volk_get_machine(void)
 {
-  extern struct volk_machine *volk_machines[];
-  extern unsigned int n_volk_machines;
-  static struct volk_machine *machine = NULL;
+  return get_machine()->name;
+}
 
-  if(machine != NULL)
-    return machine->name;
-  else {
-    unsigned int max_score = 0;
-    unsigned int i;
-    struct volk_machine *max_machine = NULL;
-    for(i=0; i<n_volk_machines; i++) {
-      if(!(volk_machines[i]->caps & (~volk_get_lvarch()))) {
-        if(volk_machines[i]->caps > max_score) {
-          max_score = volk_machines[i]->caps;
-          max_machine = volk_machines[i];
+size_t volk_get_alignment(void)
+{
+    return get_machine()->alignment;
+}
+
+void volk_fp_env_enter(volk_fp_env_t *env)
+{
+    env->saved = get_machine()->fp_env_enter();
+}
+
+void volk_fp_env_leave(const volk_fp_env_t *env)
+{
+    get_machine()->fp_env_leave(env->saved);
+}
+
+//the dispatchers only need the mask; a stale (all ones) mask picks _u
+static inline bool __volk_is_aligned(const void *ptr)
+{
+    return ((intptr_t)(ptr) & volk_atomic_load_relaxed(&__alignment_mask)) == 0;
+}
+
+bool volk_is_aligned(const void *ptr)
+{
+    get_machine(); //ensures the mask is set
+    return __volk_is_aligned(ptr);
+}
+
+#if defined(VOLK_STATS)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#define __VOLK_N_KERNELS ${len(kernels)}
+
+static const char *__volk_kernel_names[__VOLK_N_KERNELS] = {
+%for kern in kernels:
+    "${kern.name}",
+%endfor
+};
+
+struct __volk_kernel_counters
+{
+    uint64_t calls;
+    uint64_t points;
+    uint64_t aligned_calls;
+    uint64_t cycles;
+    uint64_t len_hist[VOLK_STATS_LEN_BINS];
+};
+
+/* Every thread that calls a dispatcher owns one block of counters, so
+ * the only writer of a counter is its thread and no read-modify-write
+ * has to be atomic. Blocks are linked into a global list under a lock;
+ * an exiting thread adds its counts to the retired block and frees its
+ * own, so the counts of a thread outlive it.
+ */
+struct __volk_thread_stats
+{
+    struct __volk_thread_stats *next;
+    struct __volk_kernel_counters kernels[__VOLK_N_KERNELS];
+};
+
+static struct __volk_thread_stats *__volk_all_stats = NULL;
+static struct __volk_kernel_counters __volk_retired_stats[__VOLK_N_KERNELS];
+static int __volk_stats_locked = 0;
+static __VOLK_THREAD_LOCAL struct __volk_thread_stats *__volk_my_stats = NULL;
+
+//-1 until VOLK_STATS_CYCLES has been read from the environment
+static int __volk_stats_cycles = -1;
+
+//held for list changes and reads, never on the counting path
+static void __volk_stats_lock(void)
+{
+    int unlocked = 0;
+    while (!volk_atomic_cas(&__volk_stats_locked, &unlocked, 1))
+        unlocked = 0;
+}
+
+static void __volk_stats_unlock(void)
+{
+    volk_atomic_store_release(&__volk_stats_locked, 0);
+}
+
+#if defined(HAVE_PTHREAD)
+#include <pthread.h>
+
+static pthread_key_t __volk_stats_exit_key;
+static pthread_once_t __volk_stats_exit_once = PTHREAD_ONCE_INIT;
+static int __volk_stats_exit_key_ok;
+
+//an exiting thread retires its counts and frees its block
+static void __volk_stats_thread_exit(void *arg)
+{
+    struct __volk_thread_stats *stats = (struct __volk_thread_stats *)arg;
+    struct __volk_thread_stats **link;
+    size_t k, bin;
+
+    __volk_stats_lock();
+    for (k = 0; k < __VOLK_N_KERNELS; k++) {
+        struct __volk_kernel_counters *retired = &__volk_retired_stats[k];
+        const struct __volk_kernel_counters *counters = &stats->kernels[k];
+        retired->calls += counters->calls;
+        retired->points += counters->points;
+        retired->aligned_calls += counters->aligned_calls;
+        retired->cycles += counters->cycles;
+        for (bin = 0; bin < VOLK_STATS_LEN_BINS; bin++) {
+            retired->len_hist[bin] += counters->len_hist[bin];
         }
-      }
     }
-    machine = max_machine;
-    return machine->name;
-  }
+    for (link = &__volk_all_stats; *link != stats; link = &(*link)->next);
+    *link = stats->next;
+    __volk_stats_unlock();
+    __volk_my_stats = NULL;
+    free(stats);
 }
 
-size_t volk_get_alignment(void)
+static void __volk_stats_exit_key_create(void)
 {
-    get_machine(); //ensures alignment is set
-    return __alignment;
+    __volk_stats_exit_key_ok = pthread_key_create(&__volk_stats_exit_key, __volk_stats_thread_exit) == 0;
 }
+#endif
 
-bool volk_is_aligned(const void *ptr)
+static struct __volk_thread_stats *__volk_stats_register(void)
+{
+    struct __volk_thread_stats *stats =
+        (struct __volk_thread_stats *) calloc(1, sizeof(struct __volk_thread_stats));
+    if (stats == NULL) return NULL;
+    __volk_stats_lock();
+    stats->next = __volk_all_stats;
+    __volk_all_stats = stats;
+    __volk_stats_unlock();
+#if defined(HAVE_PTHREAD)
+    pthread_once(&__volk_stats_exit_once, __volk_stats_exit_key_create);
+    if (__volk_stats_exit_key_ok) pthread_setspecific(__volk_stats_exit_key, stats);
+#endif
+    __volk_my_stats = stats;
+    return stats;
+}
+
+static inline uint64_t __volk_stats_now(void)
+{
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    return __rdtsc();
+#elif defined(_WIN32)
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return (uint64_t)count.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+//only the owning thread writes, so a relaxed load and store is enough
+static inline void __volk_stats_add(uint64_t *counter, uint64_t n)
+{
+    volk_atomic_store_relaxed(counter, volk_atomic_load_relaxed(counter) + n);
+}
+
+//bin 0 counts empty calls, bin i lengths in [2^(i-1), 2^i)
+static inline unsigned int __volk_stats_bin(unsigned int len)
+{
+    unsigned int bin = 0;
+    while (len != 0) {
+        bin++;
+        len >>= 1;
+    }
+    return bin;
+}
+
+//counts a call; returns its start time, or 0 when cycles are not counted
+static inline uint64_t __volk_stats_enter(size_t kernel, bool aligned, unsigned int len)
+{
+    struct __volk_thread_stats *stats = __volk_my_stats;
+    struct __volk_kernel_counters *counters;
+    int cycles = volk_atomic_load_relaxed(&__volk_stats_cycles);
+
+    if (stats == NULL) stats = __volk_stats_register();
+    if (stats == NULL) return 0;
+    counters = &stats->kernels[kernel];
+    __volk_stats_add(&counters->calls, 1);
+    __volk_stats_add(&counters->points, len);
+    __volk_stats_add(&counters->aligned_calls, aligned);
+    __volk_stats_add(&counters->len_hist[__volk_stats_bin(len)], 1);
+
+    if (cycles < 0) {
+        const char *env = getenv("VOLK_STATS_CYCLES");
+        cycles = env != NULL && env[0] != '\0' && strcmp(env, "0") != 0;
+        volk_atomic_store_relaxed(&__volk_stats_cycles, cycles);
+    }
+    return cycles? __volk_stats_now() : 0;
+}
+
+static inline void __volk_stats_leave(size_t kernel, uint64_t start)
+{
+    if (start != 0) {
+        __volk_stats_add(&__volk_my_stats->kernels[kernel].cycles, __volk_stats_now() - start);
+    }
+}
+
+size_t volk_get_stats(volk_kernel_stats_t *stats, size_t max_stats)
 {
-    return ((intptr_t)(ptr) & __alignment_mask) == 0;
+    const struct __volk_thread_stats *thread;
+    size_t k, bin;
+
+    if (max_stats > __VOLK_N_KERNELS) max_stats = __VOLK_N_KERNELS;
+    memset(stats, 0, max_stats * sizeof(*stats));
+    for (k = 0; k < max_stats; k++) {
+        stats[k].name = __volk_kernel_names[k];
+    }
+    __volk_stats_lock();
+    for (k = 0; k < max_stats; k++) {
+        const struct __volk_kernel_counters *retired = &__volk_retired_stats[k];
+        stats[k].calls = retired->calls;
+        stats[k].points = retired->points;
+        stats[k].aligned_calls = retired->aligned_calls;
+        stats[k].cycles = retired->cycles;
+        memcpy(stats[k].len_hist, retired->len_hist, sizeof(stats[k].len_hist));
+    }
+    for (thread = __volk_all_stats; thread != NULL; thread = thread->next) {
+        for (k = 0; k < max_stats; k++) {
+            const struct __volk_kernel_counters *counters = &thread->kernels[k];
+            stats[k].calls += volk_atomic_load_relaxed(&counters->calls);
+            stats[k].points += volk_atomic_load_relaxed(&counters->points);
+            stats[k].aligned_calls += volk_atomic_load_relaxed(&counters->aligned_calls);
+            stats[k].cycles += volk_atomic_load_relaxed(&counters->cycles);
+            for (bin = 0; bin < VOLK_STATS_LEN_BINS; bin++) {
+                stats[k].len_hist[bin] += volk_atomic_load_relaxed(&counters->len_hist[bin]);
+            }
+        }
+    }
+    __volk_stats_unlock();
+    return __VOLK_N_KERNELS;
+}
+
+void volk_dump_stats(void)
+{
+    //on the heap, so that threads dumping at once each have their own
+    volk_kernel_stats_t *stats =
+        (volk_kernel_stats_t *) malloc(__VOLK_N_KERNELS * sizeof(volk_kernel_stats_t));
+    size_t k, bin;
+
+    if (stats == NULL) return;
+    volk_get_stats(stats, __VOLK_N_KERNELS);
+    printf("%-40s %12s %14s %9s %12s\n", "kernel", "calls", "points", "aligned", "cycles/call");
+    for (k = 0; k < __VOLK_N_KERNELS; k++) {
+        if (stats[k].calls == 0) continue;
+        printf("%-40s %12llu %14llu %8.1f%% %12.1f\n", stats[k].name,
+               (unsigned long long)stats[k].calls, (unsigned long long)stats[k].points,
+               100.0 * (double)stats[k].aligned_calls / (double)stats[k].calls,
+               (double)stats[k].cycles / (double)stats[k].calls);
+        printf("    lengths:");
+        for (bin = 0; bin < VOLK_STATS_LEN_BINS; bin++) {
+            if (stats[k].len_hist[bin] == 0) continue;
+            printf(" %llu+:%llu", (bin == 0)? 0ull : 1ull << (bin - 1),
+                   (unsigned long long)stats[k].len_hist[bin]);
+        }
+        printf("\n");
+    }
+    free(stats);
+}
+
+#else
+
+size_t volk_get_stats(volk_kernel_stats_t *stats, size_t max_stats)
+{
+    (void)stats;
+    (void)max_stats;
+    return 0;
+}
+
+void volk_dump_stats(void)
+{
+    printf("Volk was built without kernel statistics, configure with -DENABLE_STATS=ON\n");
+}
+
+#endif //defined(VOLK_STATS)
+
+#if defined(VOLK_IFUNC)
+/* The machine the IFUNC resolvers bind from. They run while volk is
+ * relocated, when other libraries may not be yet, so this only runs the
+ * cpuid checks: no volk_config, no environment and no allocation.
+ */
+static struct volk_machine *__volk_ifunc_machine(void)
+{
+    static struct volk_machine *machine = NULL;
+    struct volk_machine *best = volk_atomic_load_relaxed(&machine);
+    if(best == NULL) {
+        best = __volk_best_machine(volk_cpu_probe());
+        volk_atomic_store_relaxed(&machine, best);
+    }
+    return best;
 }
+#endif
 
 #define LV_HAVE_GENERIC
 #define LV_HAVE_DISPATCHER
 
 %for kern in kernels:
+<% kern_index = loop.index %>\
 
 %if kern.has_dispatcher:
 #include <volk/${kern.name}.h> //pulls in the dispatcher
 %endif
 
+<% has_buckets = kern.len_arg and not kern.has_dispatcher %>
+%if has_buckets:
+/* Implementations for ${kern.len_arg} below max_len, ascending and ended by
+ * a zero max_len; NULL unless the config gives length buckets.
+ */
+struct __${kern.name}_bucket
+{
+    unsigned int max_len;
+    ${kern.pname} impl_a;
+    ${kern.pname} impl_u;
+};
+static const struct __${kern.name}_bucket *__${kern.name}_buckets = NULL;
+
+%endif
+<% can_peel = kern.peelable and kern.len_arg and not kern.has_dispatcher %>
+%if can_peel:
+<% ptr_names = [arg_name for arg_type, arg_name in kern.args if '*' in arg_type] %>
+//set when the aligned binding is not the unaligned one, so peeling pays
+static int __${kern.name}_peels = 0;
+
+/* The points to run before every buffer reaches the machine alignment,
+ * or ${kern.len_arg} when the buffers are misaligned relative to each other.
+ */
+static inline unsigned int __${kern.name}_peel(${kern.arglist_full})
+{
+    const intptr_t mask = volk_atomic_load_relaxed(&__alignment_mask);
+    const size_t to_boundary = (size_t)(-(intptr_t)(${ptr_names[0]}) & mask);
+    const unsigned int peel = (unsigned int)(to_boundary / sizeof(*${ptr_names[0]}));
+
+    if (to_boundary % sizeof(*${ptr_names[0]}) != 0 || peel >= ${kern.len_arg}) return ${kern.len_arg};
+    %for arg_name in ptr_names[1:]:
+    if (((intptr_t)(${arg_name} + peel) & mask) != 0) return ${kern.len_arg};
+    %endfor
+    return peel;
+}
+
+%endif
+<%
+    aligned_ptrs = [arg_name for arg_type, arg_name in kern.args if '*' in arg_type]
+    aligned_test = ''.join('VOLK_OR_PTR(%s, '%arg_name for arg_name in aligned_ptrs) + '0' + ')'*len(aligned_ptrs)
+%>\
 static inline void __${kern.name}_d(${kern.arglist_full})
 {
     %if kern.has_dispatcher:
+#if defined(VOLK_STATS)
+    const uint64_t stats_start = __volk_stats_enter(${kern_index}, __volk_is_aligned(${aligned_test}), ${kern.len_arg or 0});
+#endif
     ${kern.name}_dispatcher(${kern.arglist_names});
-    return;
+#if defined(VOLK_STATS)
+    __volk_stats_leave(${kern_index}, stats_start);
+#endif
+    %else:
+    const bool aligned = __volk_is_aligned(${aligned_test});
+#if defined(VOLK_STATS)
+    const uint64_t stats_start = __volk_stats_enter(${kern_index}, aligned, ${kern.len_arg or 0});
+#endif
+    %if has_buckets:
+    const struct __${kern.name}_bucket *bucket = volk_atomic_load_acquire(&__${kern.name}_buckets);
+    if (bucket != NULL) {
+        for (; bucket->max_len != 0; bucket++) {
+            if (${kern.len_arg} < bucket->max_len) {
+                (aligned? bucket->impl_a : bucket->impl_u)(${kern.arglist_names});
+#if defined(VOLK_STATS)
+                __volk_stats_leave(${kern_index}, stats_start);
+#endif
+                return;
+            }
+        }
+    }
     %endif
-
-    if (volk_is_aligned(<% num_open_parens = 0 %>
-    %for arg_type, arg_name in kern.args:
-        %if '*' in arg_type:
-        VOLK_OR_PTR(${arg_name},<% num_open_parens += 1 %>
-        %endif
-    %endfor
-        0<% end_open_parens = ')'*num_open_parens %>${end_open_parens}
-    )){
-        ${kern.name}_a(${kern.arglist_names});
+    if (aligned){
+        volk_atomic_load_acquire(&${kern.name}_a)(${kern.arglist_names});
     }
     else{
-        ${kern.name}_u(${kern.arglist_names});
+        %if can_peel:
+<%
+    prologue_args = ', '.join('peel' if arg_name == kern.len_arg else arg_name for arg_type, arg_name in kern.args)
+    body_args = ', '.join('%s + peel'%arg_name if '*' in arg_type else '%s - peel'%arg_name if arg_name == kern.len_arg else arg_name for arg_type, arg_name in kern.args)
+%>\
+        //run up to the alignment boundary unaligned, the rest aligned
+        const unsigned int peel = volk_atomic_load_relaxed(&__${kern.name}_peels)?
+            __${kern.name}_peel(${kern.arglist_names}) : ${kern.len_arg};
+        if (peel < ${kern.len_arg}) {
+            volk_atomic_load_acquire(&${kern.name}_u)(${prologue_args});
+            volk_atomic_load_acquire(&${kern.name}_a)(${body_args});
+        }
+        else{
+            volk_atomic_load_acquire(&${kern.name}_u)(${kern.arglist_names});
+        }
+        %else:
+        volk_atomic_load_acquire(&${kern.name}_u)(${kern.arglist_names});
+        %endif
+    }
+#if defined(VOLK_STATS)
+    __volk_stats_leave(${kern_index}, stats_start);
+#endif
+    %endif
+}
+
+%if has_buckets:
+/* Publishes the length buckets from the config, or NULL when there are
+ * none. A replaced table is never freed: a dispatch in another thread
+ * may still be reading it.
+ */
+static inline void __init_${kern.name}_buckets(struct volk_machine *machine)
+{
+    unsigned int max_lens[VOLK_MAX_LEN_BUCKETS];
+    int index_a[VOLK_MAX_LEN_BUCKETS];
+    int index_u[VOLK_MAX_LEN_BUCKETS];
+    struct __${kern.name}_bucket *buckets = NULL;
+    const size_t n_buckets = volk_rank_archs_buckets(machine->${kern.name}_name,
+        machine->${kern.name}_impl_names, machine->${kern.name}_n_impls,
+        max_lens, index_a, index_u);
+    size_t i;
+
+    if (n_buckets > 0) {
+        buckets = (struct __${kern.name}_bucket *) calloc(n_buckets + 1, sizeof(*buckets));
+    }
+    if (buckets != NULL) {
+        for (i = 0; i < n_buckets; i++) {
+            buckets[i].max_len = max_lens[i];
+            buckets[i].impl_a = machine->${kern.name}_impls[index_a[i]];
+            buckets[i].impl_u = machine->${kern.name}_impls[index_u[i]];
+        }
+    }
+
+    //racing first calls and repeated inits with the same config keep the
+    //published table, so only a changed config leaves one behind
+    const struct __${kern.name}_bucket *current = volk_atomic_load_acquire(&__${kern.name}_buckets);
+    bool same = (current == NULL) == (buckets == NULL);
+    for (i = 0; same && buckets != NULL && i <= n_buckets; i++) {
+        same = current[i].max_len == buckets[i].max_len &&
+               current[i].impl_a == buckets[i].impl_a && current[i].impl_u == buckets[i].impl_u;
+    }
+    if (same || !volk_atomic_cas(&__${kern.name}_buckets, &current, (const struct __${kern.name}_bucket *)buckets)) {
+        free(buckets);
     }
 }
 
+%endif
+/* Binds the ranked implementations. Racing threads bind the same ones;
+ * the release stores pair with the acquire loads in the dispatcher, so a
+ * thread that sees a bound implementation also sees the alignment mask.
+ */
 static inline void __init_${kern.name}(void)
 {
-    const char *name = get_machine()->${kern.name}_name;
-    const char **impl_names = get_machine()->${kern.name}_impl_names;
-    const int *impl_deps = get_machine()->${kern.name}_impl_deps;
-    const bool *alignment = get_machine()->${kern.name}_impl_alignment;
-    const size_t n_impls = get_machine()->${kern.name}_n_impls;
+    struct volk_machine *machine = get_machine();
+    const char *name = machine->${kern.name}_name;
+    const char **impl_names = machine->${kern.name}_impl_names;
+    const int *impl_deps = machine->${kern.name}_impl_deps;
+    const bool *alignment = machine->${kern.name}_impl_alignment;
+    const size_t n_impls = machine->${kern.name}_n_impls;
     const size_t index_a = volk_rank_archs(name, impl_names, impl_deps, alignment, n_impls, true/*aligned*/);
     const size_t index_u = volk_rank_archs(name, impl_names, impl_deps, alignment, n_impls, false/*unaligned*/);
-    ${kern.name}_a = get_machine()->${kern.name}_impls[index_a];
-    ${kern.name}_u = get_machine()->${kern.name}_impls[index_u];
 
-    assert(${kern.name}_a);
-    assert(${kern.name}_u);
+    assert(machine->${kern.name}_impls[index_a]);
+    assert(machine->${kern.name}_impls[index_u]);
 
-    ${kern.name} = &__${kern.name}_d;
+    %if has_buckets:
+    __init_${kern.name}_buckets(machine);
+    %endif
+    %if kern.peelable and kern.len_arg and not kern.has_dispatcher:
+    volk_atomic_store_relaxed(&__${kern.name}_peels, index_a != index_u);
+    %endif
+    volk_atomic_store_release(&${kern.name}_a, machine->${kern.name}_impls[index_a]);
+    volk_atomic_store_release(&${kern.name}_u, machine->${kern.name}_impls[index_u]);
 }
 
 static inline void __${kern.name}_a(${kern.arglist_full})
 {
     __init_${kern.name}();
-    ${kern.name}_a(${kern.arglist_names});
+    volk_atomic_load_acquire(&${kern.name}_a)(${kern.arglist_names});
 }
 
 static inline void __${kern.name}_u(${kern.arglist_full})
 {
     __init_${kern.name}();
-    ${kern.name}_u(${kern.arglist_names});
-}
-
-static inline void __${kern.name}(${kern.arglist_full})
-{
-    __init_${kern.name}();
-    ${kern.name}(${kern.arglist_names});
+    volk_atomic_load_acquire(&${kern.name}_u)(${kern.arglist_names});
 }
 
+//the dispatcher itself never changes; only the _a/_u bindings behind it do
 ${kern.pname} ${kern.name}_a = &__${kern.name}_a;
 ${kern.pname} ${kern.name}_u = &__${kern.name}_u;
-${kern.pname} ${kern.name}   = &__${kern.name};
+${kern.pname} ${kern.name}   = &__${kern.name}_d;
+#if defined(VOLK_IFUNC)
+/* Runs once while volk is relocated, so callers of ${kern.name}_ifunc
+ * jump straight into the machine's entry, which checks the alignment
+ * and calls the default ranked _a or _u implementation.
+ */
+static ${kern.pname} __${kern.name}_resolve(void)
+{
+    %if kern.has_dispatcher:
+    return &__${kern.name}_d;
+    %else:
+    return __volk_ifunc_machine()->${kern.name}_entry;
+    %endif
+}
+void ${kern.name}_ifunc(${kern.arglist_full}) __attribute__((ifunc("__${kern.name}_resolve")));
+#endif
 
 void ${kern.name}_manual(${kern.arglist_full}, const char* impl_name)
 {
@@ -208,3 +635,37 @@ volk_func_desc_t ${kern.name}_get_func_desc(void) {
 }
 
 %endfor
+
+static double __volk_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+double volk_init_with_config(const char *config_path)
+{
+    const double start = __volk_seconds();
+
+    get_machine();
+    if(volk_rank_archs_load_prefs(config_path) == VOLK_PREFS_UNREADABLE) {
+        fprintf(stderr, "Volk warning: cannot read %s, using the default kernel ranking\n", config_path);
+    }
+    %for kern in kernels:
+    __init_${kern.name}();
+    %endfor
+
+    return __volk_seconds() - start;
+}
+
+double volk_init(void)
+{
+    return volk_init_with_config(NULL);
+}
@@ -30,6 +30,7 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 __VOLK_DECL_BEGIN
 
@@ -50,6 +51,53 @@ VOLK_API const char* volk_get_machine(void);
 //! Get the machine alignment in bytes
 VOLK_API size_t volk_get_alignment(void);
 
+//! The floating point state volk_fp_env_enter saves for volk_fp_env_leave
+typedef struct volk_fp_env {
+    unsigned int saved;
+} volk_fp_env_t;
+
+/*!
+ * Switch the calling thread to the floating point environment the
+ * selected machine's architectures declare, e.g. flush-to-zero and
+ * denormals-are-zero on SSE machines. Denormal inputs and results then
+ * read as zero instead of taking the slow microcode path, which keeps
+ * decaying IIR and AGC tails fast, at the price of strict IEEE 754
+ * behaviour for tiny values. A no-op on machines without such settings.
+ *
+ * The environment is per thread: call this in every thread that runs
+ * the kernels and pair it with volk_fp_env_leave in the same thread.
+ *
+ * \param env receives the previous state
+ */
+VOLK_API void volk_fp_env_enter(volk_fp_env_t *env);
+
+/*!
+ * Restore the floating point environment volk_fp_env_enter saved.
+ *
+ * \param env the state filled in by the matching volk_fp_env_enter
+ */
+VOLK_API void volk_fp_env_leave(const volk_fp_env_t *env);
+
+/*!
+ * Select the machine, load the preferences and bind every kernel now
+ * rather than on its first call, so no call pays for initialization.
+ *
+ * Preferences come from the usual volk_config location; see
+ * volk_init_with_config to name the file explicitly.
+ *
+ * \return the time the initialization took in seconds
+ */
+VOLK_API double volk_init(void);
+
+/*!
+ * Like volk_init, but read kernel preferences from config_path.
+ * Kernels that were already bound are rebound with the new preferences.
+ *
+ * \param config_path path to a volk_config file, or NULL for the default
+ * \return the time the initialization took in seconds
+ */
+VOLK_API double volk_init_with_config(const char *config_path);
+
 /*!
  * The VOLK_OR_PTR macro is a convenience macro
  * for checking the alignment of a set of pointers.
@@ -71,12 +119,57 @@ VOLK_API size_t volk_get_alignment(void);
  */
 VOLK_API bool volk_is_aligned(const void *ptr);
 
+//! Length histogram bins: bin 0 counts empty calls, bin i lengths in [2^(i-1), 2^i)
+#define VOLK_STATS_LEN_BINS 33
+
+//! Dispatcher call counts of one kernel, summed over all threads
+typedef struct volk_kernel_stats
+{
+    const char *name;
+    uint64_t calls;
+    uint64_t points;        //!< sum of num_points; 0 for kernels without one
+    uint64_t aligned_calls; //!< calls that took the _a path, the rest took _u
+    uint64_t cycles;        //!< time in the kernel when VOLK_STATS_CYCLES is set
+    uint64_t len_hist[VOLK_STATS_LEN_BINS];
+} volk_kernel_stats_t;
+
+/*!
+ * \brief Read the dispatcher statistics of every kernel.
+ *
+ * Only calls through the dispatchers (volk_x, not volk_x_a/_u or
+ * volk_x_manual) are counted, including kernels that bring their own
+ * dispatcher, and only when volk is configured with
+ * -DENABLE_STATS=ON; the volk_x_ifunc entries of an ENABLE_IFUNC build
+ * are not counted. Cycles are timestamp counter ticks on x86 and
+ * nanoseconds elsewhere. Counters of running threads are read without
+ * stopping them, so a snapshot may be a few calls behind.
+ *
+ * \param stats receives up to max_stats entries in kernel order
+ * \param max_stats the size of stats
+ * \return the number of kernels, or 0 if statistics are not built in
+ */
+VOLK_API size_t volk_get_stats(volk_kernel_stats_t *stats, size_t max_stats);
+
+//! Prints the statistics of every kernel that has been called
+VOLK_API void volk_dump_stats(void);
 
 %for kern in kernels:
 
 //! A function pointer to the dispatcher implementation
 extern VOLK_API ${kern.pname} ${kern.name};
 
+#if defined(VOLK_IFUNC)
+/*!
+ * The implementation for any alignment, bound when volk is loaded.
+ * It is the default ranking for the machine, so volk_config,
+ * volk_init_with_config(), VOLK_GENERIC, length buckets and peeling
+ * have no effect on it, and volk_get_stats() does not count it.
+ * ${kern.name} and ${kern.name}_a/_u still follow volk_config and
+ * VOLK_GENERIC.
+ */
+extern VOLK_API void ${kern.name}_ifunc(${kern.arglist_full});
+#endif
+
 //! A function pointer to the fastest aligned implementation
 extern VOLK_API ${kern.pname} ${kern.name}_a;
 
@@ -26,4 +26,9 @@
 #define LV_${arch.name.upper()} ${i}
 %endfor
 
+%if 'ifunc' in args:
+//the kernel entry points are functions resolved at load time
+#define VOLK_IFUNC
+
+%endif
 #endif /*INCLUDED_VOLK_CONFIG_FIXED*/
@@ -21,6 +21,7 @@
 
 #include <volk/volk_cpu.h>
 #include <volk/volk_config_fixed.h>
+#include "volk_atomic.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -32,8 +33,16 @@ struct VOLK_CPU volk_cpu;
 
 #if defined(VOLK_CPU_x86)
 
+//the QA build swaps the cpuid and xgetbv instructions for a canned CPU profile
+#if defined(VOLK_CPU_STUB)
+    extern void volk_cpu_stub_cpuid(unsigned int op, unsigned int count, unsigned int *regs);
+    extern unsigned long long volk_cpu_stub_xgetbv(void);
+    #define cpuid_x86(op, r) volk_cpu_stub_cpuid(op, 0, (unsigned int *)r)
+    #define cpuid_x86_count(op, count, regs) volk_cpu_stub_cpuid(op, count, (unsigned int *)regs)
+    #define __xgetbv() volk_cpu_stub_xgetbv()
+
 //implement get cpuid for gcc compilers using a system or local copy of cpuid.h
-#if defined(__GNUC__)
+#elif defined(__GNUC__)
     #include <cpuid.h>
     #define cpuid_x86(op, r) __get_cpuid(op, (unsigned int *)r+0, (unsigned int *)r+1, (unsigned int *)r+2, (unsigned int *)r+3)
     #define cpuid_x86_count(op, count, regs) __cpuid_count(op, count, *((unsigned int*)regs), *((unsigned int*)regs+1), *((unsigned int*)regs+2), *((unsigned int*)regs+3))
@@ -83,8 +92,7 @@ static inline unsigned int cpuid_count_x86_bit(unsigned int level, unsigned int
 
 static inline unsigned int cpuid_x86_bit(unsigned int reg, unsigned int op, unsigned int bit) {
 #if defined(VOLK_CPU_x86)
-    unsigned int regs[4];
-    memset(regs, 0, sizeof(unsigned int)*4);
+    unsigned int regs[4] = {0};
     cpuid_x86(op, regs);
     return regs[reg] >> bit & 0x01;
 #else
@@ -94,8 +102,7 @@ static inline unsigned int cpuid_x86_bit(unsigned int reg, unsigned int op, unsi
 
 static inline unsigned int check_extended_cpuid(unsigned int val) {
 #if defined(VOLK_CPU_x86)
-    unsigned int regs[4];
-    memset(regs, 0, sizeof(unsigned int)*4);
+    unsigned int regs[4] = {0};
     cpuid_x86(0x80000000, regs);
     return regs[0] >= val;
 #else
@@ -103,20 +110,36 @@ static inline unsigned int check_extended_cpuid(unsigned int val) {
 #endif
 }
 
-static inline unsigned int get_avx_enabled(void) {
+/* State components of XCR0 the OS has to save and restore on a context
+ * switch before the matching registers may be used.
+ */
+#define VOLK_XCR0_SSE    0x02 /* XMM0-15 and MXCSR */
+#define VOLK_XCR0_AVX    0x04 /* upper halves of YMM0-15 */
+#define VOLK_XCR0_OPMASK 0x20 /* k0-k7 */
+#define VOLK_XCR0_ZMM    0xC0 /* upper halves of ZMM0-15 and ZMM16-31 */
+
+/* Returns 1 only if every requested component is enabled; callers must
+ * have checked OSXSAVE first since xgetbv faults without it.
+ */
+static inline unsigned int get_xcr0_enabled(unsigned long long components) {
 #if defined(VOLK_CPU_x86)
-    return __xgetbv() & 0x6;
+    return (__xgetbv() & components) == components;
 #else
     return 0;
 #endif
 }
 
+static inline unsigned int get_avx_enabled(void) {
+    return get_xcr0_enabled(VOLK_XCR0_SSE | VOLK_XCR0_AVX);
+}
+
+/* AVX2 adds instructions but no registers, so it needs the same state as AVX */
 static inline unsigned int get_avx2_enabled(void) {
-#if defined(VOLK_CPU_x86)
-    return __xgetbv() & 0x6;
-#else
-    return 0;
-#endif
+    return get_xcr0_enabled(VOLK_XCR0_SSE | VOLK_XCR0_AVX);
+}
+
+static inline unsigned int get_avx512_enabled(void) {
+    return get_xcr0_enabled(VOLK_XCR0_SSE | VOLK_XCR0_AVX | VOLK_XCR0_OPMASK | VOLK_XCR0_ZMM);
 }
 
 //neon detection is linux specific
@@ -192,11 +215,32 @@ void volk_cpu_init() {
     set_float_rounding();
 }
 
-unsigned int volk_get_lvarch() {
+unsigned int volk_cpu_probe() {
     unsigned int retval = 0;
-    volk_cpu_init();
     %for arch in archs:
-    retval += volk_cpu.has_${arch.name}() << LV_${arch.name.upper()};
+    retval += i_can_has_${arch.name}() << LV_${arch.name.upper()};
     %endfor
     return retval;
 }
+
+unsigned int volk_get_lvarch() {
+    //the cpu does not change under us, so only probe it once; the first
+    //caller runs the init and publishes the mask, racing callers wait
+    //for it so that volk_cpu is filled in by the time they return
+    static unsigned int lvarch = 0;
+    static volatile int probed = 0;
+    static int init_claimed = 0;
+    int unclaimed = 0;
+    unsigned int retval = 0;
+    if(volk_atomic_load_acquire(&probed)) return volk_atomic_load_relaxed(&lvarch);
+    if(!volk_atomic_cas(&init_claimed, &unclaimed, 1)) {
+        //the winner only runs the cpuid checks, so this is a short wait
+        while(!volk_atomic_load_acquire(&probed));
+        return volk_atomic_load_relaxed(&lvarch);
+    }
+    volk_cpu_init();
+    retval = volk_cpu_probe();
+    volk_atomic_store_relaxed(&lvarch, retval);
+    volk_atomic_store_release(&probed, 1);
+    return retval;
+}
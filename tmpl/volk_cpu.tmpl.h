@@ -37,6 +37,12 @@ extern struct VOLK_CPU volk_cpu;
 void volk_cpu_init ();
 unsigned int volk_get_lvarch ();
 
+/* The cpuid checks alone, without filling in volk_cpu or setting the
+ * rounding mode. On x86 this makes no library calls, so the IFUNC
+ * resolvers can run it while volk is being relocated.
+ */
+unsigned int volk_cpu_probe ();
+
 __VOLK_DECL_END
 
 #endif /*INCLUDED_VOLK_CPU_H*/
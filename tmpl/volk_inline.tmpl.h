@@ -0,0 +1,201 @@
+/*
+ * Copyright 2018 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*!
+ * \file volk_inline.h
+ * \brief Binds every kernel at compile time, without the runtime dispatcher.
+ *
+ * Include this instead of volk/volk.h to make each volk_x a static inline
+ * function that calls the implementation volk_rank_archs() would pick,
+ * so the compiler can inline short kernels into their callers. The
+ * target is the machine named by defining VOLK_INLINE_MACHINE_<NAME>
+ * (e.g. VOLK_INLINE_MACHINE_AVX2_64_MMX) before the include, or else
+ * whatever the compiler flags enable (-march=...). The code must be
+ * compiled for that machine and never runs on a lesser one. Preferences
+ * in volk_config, length buckets and the Orc and asm implementations do
+ * not apply; volk_malloc() and friends still come from the library.
+ *
+ * This only pays off for short vectors, where the dispatcher's indirect
+ * call and alignment check are a sizable part of the work. In
+ * apps/volk_bench_inline the inline binding ran 1.3-1.7x faster at 64
+ * points, but no faster and often slower (0.85-0.97x) at 256 points.
+ * Past a few dozen points, keep using volk/volk.h.
+ */
+
+#ifndef INCLUDED_VOLK_INLINE_H
+#define INCLUDED_VOLK_INLINE_H
+
+#if defined(INCLUDED_VOLK_RUNTIME)
+#error "volk_inline.h replaces volk/volk.h, include only one of them"
+#endif
+
+<%
+    all_archs = context.get('archs')
+    all_arch_dict = context.get('arch_dict')
+
+    def rank(impl):
+        return sum(1 << all_archs.index(all_arch_dict[dep]) for dep in impl.deps if dep in all_arch_dict)
+
+    def candidates(kern, aligned):
+        impls = [impl for impl in kern._impls if impl.has_body and impl.is_aligned == aligned and 'orc' not in impl.deps]
+        return sorted(impls, key=rank, reverse=True)
+
+    def condition(impl):
+        return ' && '.join('defined(LV_HAVE_%s)'%dep.upper() for dep in sorted(impl.deps))
+
+    def alignment(impl):
+        return max(all_arch_dict[dep].alignment for dep in impl.deps if dep in all_arch_dict)
+
+    inline_kernels = [kern for kern in kernels if 'puppet' not in kern.name and not kern.has_dispatcher]
+%>
+%for machine in machines:
+%if 'orc' not in machine.arch_names:
+#if defined(VOLK_INLINE_MACHINE_${machine.name.upper()})
+#define __VOLK_INLINE_MACHINE
+%for arch in machine.archs:
+#define LV_HAVE_${arch.name.upper()} 1
+%endfor
+#endif
+%endif
+%endfor
+
+//no machine given: take the architectures the compiler targets
+#if !defined(__VOLK_INLINE_MACHINE)
+#define LV_HAVE_GENERIC 1
+#if defined(__x86_64__) || defined(_M_X64)
+#define LV_HAVE_64 1
+#elif defined(__i386__) || defined(_M_IX86)
+#define LV_HAVE_32 1
+#endif
+#if defined(__MMX__)
+#define LV_HAVE_MMX 1
+#endif
+#if defined(__SSE__) || defined(_M_X64)
+#define LV_HAVE_SSE 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#define LV_HAVE_SSE2 1
+#endif
+#if defined(__SSE3__)
+#define LV_HAVE_SSE3 1
+#endif
+#if defined(__SSSE3__)
+#define LV_HAVE_SSSE3 1
+#endif
+#if defined(__SSE4A__)
+#define LV_HAVE_SSE4_A 1
+#endif
+#if defined(__SSE4_1__)
+#define LV_HAVE_SSE4_1 1
+#endif
+#if defined(__SSE4_2__)
+#define LV_HAVE_SSE4_2 1
+#endif
+#if defined(__POPCNT__)
+#define LV_HAVE_POPCOUNT 1
+#endif
+#if defined(__AVX__)
+#define LV_HAVE_AVX 1
+#endif
+#if defined(__FMA__)
+#define LV_HAVE_FMA 1
+#endif
+#if defined(__AVX2__)
+#define LV_HAVE_AVX2 1
+#endif
+#if defined(__AVX512F__)
+#define LV_HAVE_AVX512F 1
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LV_HAVE_NEON 1
+#endif
+#endif
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#include <volk/volk_malloc.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+%for kern in inline_kernels:
+#include <volk/${kern.name}.h>
+%endfor
+
+#define VOLK_OR_PTR(ptr0, ptr1) \
+    (const void *)(((intptr_t)(ptr0)) | ((intptr_t)(ptr1)))
+
+%for kern in inline_kernels:
+<%
+    impls_a = candidates(kern, True)
+    impls_u = candidates(kern, False)
+%>
+//${kern.name}: the best unaligned implementation, and an aligned one if any
+%for i, impl in enumerate(impls_u):
+#${'if' if i == 0 else 'elif'} ${condition(impl)}
+#define __volk_inline_${kern.name}_u ${kern.name}_${impl.name}
+%endfor
+#else
+#error "volk_inline.h: no implementation of ${kern.name} for this machine"
+#endif
+%for i, impl in enumerate(impls_a):
+#${'if' if i == 0 else 'elif'} ${condition(impl)}
+#define __volk_inline_${kern.name}_a ${kern.name}_${impl.name}
+#define __volk_inline_${kern.name}_alignment ${alignment(impl)}
+%endfor
+%if impls_a:
+#else
+%endif
+#define __volk_inline_${kern.name}_a __volk_inline_${kern.name}_u
+#define __volk_inline_${kern.name}_alignment 0
+%if impls_a:
+#endif
+%endif
+
+static inline void ${kern.name}_a(${kern.arglist_full})
+{
+    __volk_inline_${kern.name}_a(${kern.arglist_names});
+}
+
+static inline void ${kern.name}_u(${kern.arglist_full})
+{
+    __volk_inline_${kern.name}_u(${kern.arglist_names});
+}
+
+static inline void ${kern.name}(${kern.arglist_full})
+{
+#if __volk_inline_${kern.name}_alignment
+    if ((((intptr_t)<% num_open_parens = 0 %>
+    %for arg_type, arg_name in kern.args:
+        %if '*' in arg_type:
+        VOLK_OR_PTR(${arg_name},<% num_open_parens += 1 %>
+        %endif
+    %endfor
+        0<% end_open_parens = ')'*num_open_parens %>${end_open_parens})
+        & (__volk_inline_${kern.name}_alignment - 1)) == 0) {
+        __volk_inline_${kern.name}_a(${kern.arglist_names});
+        return;
+    }
+#endif
+    __volk_inline_${kern.name}_u(${kern.arglist_names});
+}
+
+%endfor
+#endif /*INCLUDED_VOLK_INLINE_H*/
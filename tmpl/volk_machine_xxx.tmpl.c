@@ -38,10 +38,84 @@
 #include <volk/${kern.name}.h>
 %endfor
 
+<% env_archs = [arch for arch in this_machine.archs if arch.environment] %>
+%for arch in env_archs:
+#include <${arch.include}>
+%endfor
+
+//the floating point environment the archs of this machine ask for
+static unsigned int fp_env_enter_${this_machine.name}(void)
+{
+%if env_archs:
+    const unsigned int saved = _mm_getcsr();
+%for arch in env_archs:
+    ${arch.environment}
+%endfor
+    return saved;
+%else:
+    return 0;
+%endif
+}
+
+static void fp_env_leave_${this_machine.name}(unsigned int saved)
+{
+%if env_archs:
+    _mm_setcsr(saved);
+%else:
+    (void)saved;
+%endif
+}
+
+#if defined(VOLK_IFUNC)
+<%
+    arch_index = dict((arch.name, i) for i, arch in enumerate(archs))
+    def impl_deps(impl):
+        return sum(1 << arch_index[d] for d in impl.deps)
+    #ranked exactly as volk_rank_archs does without a volk_config: the
+    #largest deps mask wins and the first one on a tie, and aligned
+    #buffers take the best aligned implementation whenever there is one
+    def default_impl(impls, aligned):
+        best = None
+        for impl in impls:
+            if impl.is_aligned == aligned and (best is None or impl_deps(impl) > impl_deps(best)):
+                best = impl
+        return best
+    entry_impls = dict()
+    for kern in kernels:
+        impls = kern.get_impls(arch_names)
+        impl_u = default_impl(impls, False)
+        impl_a = default_impl(impls, True) or impl_u
+        entry_impls[kern.name] = (impl_a, impl_u)
+%>
+/* The IFUNC entry points of this machine. volk_x_ifunc is bound to them
+ * while volk is relocated, so they take the alignment branch themselves
+ * and call the default ranked implementations directly.
+ */
+%for kern in kernels:
+<% impl_a, impl_u = entry_impls[kern.name] %>
+%if impl_a is not impl_u:
+<% ptr_names = [arg_name for arg_type, arg_name in kern.args if '*' in arg_type] %>
+static void ${kern.name}_entry_${this_machine.name}(${kern.arglist_full})
+{
+    const intptr_t ptrs = ${' | '.join(['(intptr_t)(%s)'%arg_name for arg_name in ptr_names]) or '0'};
+    if ((ptrs & ${this_machine.alignment - 1}) == 0) {
+        ${kern.name}_${impl_a.name}(${kern.arglist_names});
+    }
+    else {
+        ${kern.name}_${impl_u.name}(${kern.arglist_names});
+    }
+}
+
+%endif
+%endfor
+#endif
+
 struct volk_machine volk_machine_${this_machine.name} = {
 <% make_arch_have_list = (' | '.join(['(1 << LV_%s)'%a.name.upper() for a in this_machine.archs])) %>    ${make_arch_have_list},
 <% this_machine_name = "\""+this_machine.name+"\"" %>    ${this_machine_name},
     ${this_machine.alignment},
+    fp_env_enter_${this_machine.name},
+    fp_env_leave_${this_machine.name},
 ##//list all kernels
     %for kern in kernels:
 <% impls = kern.get_impls(arch_names) %>
@@ -57,5 +131,13 @@ struct volk_machine volk_machine_${this_machine.name} = {
 <% make_impl_fcn_list = "{"+', '.join(['%s_%s'%(kern.name, i.name) for i in impls])+"}" %>    ${make_impl_fcn_list},
 ##//number of implementations listed here
 <% len_impls = len(impls) %>    ${len_impls},
+#if defined(VOLK_IFUNC)
+<% impl_a, impl_u = entry_impls[kern.name] %>\
+%if impl_a is not impl_u:
+    ${kern.name}_entry_${this_machine.name},
+%else:
+    ${kern.name}_${impl_u.name},
+%endif
+#endif
     %endfor
 };
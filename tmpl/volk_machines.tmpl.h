@@ -24,6 +24,7 @@
 
 #include <volk/volk_common.h>
 #include <volk/volk_typedefs.h>
+#include <volk/volk_config_fixed.h>
 
 #include <stdbool.h>
 #include <stdlib.h>
@@ -34,6 +35,8 @@ struct volk_machine {
     const unsigned int caps; //capabilities (i.e., archs compiled into this machine, in the volk_get_lvarch format)
     const char *name;
     const size_t alignment; //the maximum byte alignment required for functions in this library
+    unsigned int (*fp_env_enter)(void); //applies the archs' <environment>, returns the state to restore
+    void (*fp_env_leave)(unsigned int);
     %for kern in kernels:
     const char *${kern.name}_name;
     const char *${kern.name}_impl_names[<%len_archs=len(archs)%>${len_archs}];
@@ -41,6 +44,9 @@ struct volk_machine {
     const bool ${kern.name}_impl_alignment[${len_archs}];
     const ${kern.pname} ${kern.name}_impls[${len_archs}];
     const size_t ${kern.name}_n_impls;
+#if defined(VOLK_IFUNC)
+    const ${kern.pname} ${kern.name}_entry; //what the IFUNC resolver binds volk_x_ifunc to
+#endif
     %endfor
 };
 
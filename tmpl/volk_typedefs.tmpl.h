@@ -23,7 +23,9 @@
 #define INCLUDED_VOLK_TYPEDEFS
 
 #include <inttypes.h>
+#include <volk/volk_common.h>
 #include <volk/volk_complex.h>
+#include <volk/volk_resamp.h>
 
 %for kern in kernels:
 typedef void (*${kern.pname})(${kern.arglist_types});